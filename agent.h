@@ -71,6 +71,7 @@ public:
 	      int Initialize(int ide, unsigned long p, int number_of_strategies, bool naiv=false, bool prod=false);
 	      void ClearRecords(void){  bet_record=0; 
                                     frozen=true;};
+	      void ClearScores(void){ for(auto & str : strategies) str.score=0; };
 	      
 	      int Bet(unsigned long mu, unsigned long mu_naive);
 	      void UpdateScore(unsigned long mu, int A);
@@ -0,0 +1,68 @@
+/***************************************************************************
+                          bench_replay.cpp  -  description
+                             -------------------
+    begin                : October 2026
+    email                :
+ ***************************************************************************/
+
+// Measures the cost of DQNAgent::learn() for increasing replay buffer
+// capacities. With batch sampling the per-call cost should stay flat.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+
+#include "rl_agents.h"
+
+// Average learn() time in microseconds once the buffer is full
+double time_learn(int capacity, bool with_replacement, int memory_size, int calls) {
+    DQNAgent agent(memory_size, 2, 0.001, 1.0, 0.95, 0.995, 0.01,
+                   capacity, 32, 100, with_replacement, 42);
+
+    unsigned long P = 1UL << memory_size;
+    unsigned long mu = 0;
+
+    // Fill the buffer
+    for (int i = 0; i < capacity; i++) {
+        unsigned long next_mu = ((mu << 1) | (i & 1)) & (P - 1);
+        agent.learn(Observation(memory_size, mu), i & 1, 1.0,
+                    Observation(memory_size, next_mu), false);
+        mu = next_mu;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < calls; i++) {
+        unsigned long next_mu = ((mu << 1) | (i & 1)) & (P - 1);
+        agent.learn(Observation(memory_size, mu), i & 1, 1.0,
+                    Observation(memory_size, next_mu), false);
+        mu = next_mu;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double, std::micro> duration = end - start;
+    return duration.count() / calls;
+}
+
+int main(int argc, char* argv[]) {
+    int calls = (argc > 1) ? std::stoi(argv[1]) : 100000;
+    int memory_size = 3;
+    std::vector<int> capacities = {1000, 10000, 100000, 1000000};
+
+    std::cout << "DQNAgent::learn() cost vs replay capacity (batch 32, "
+              << calls << " calls)" << std::endl;
+    std::cout << std::setw(12) << "capacity"
+              << std::setw(20) << "no replacement (us)"
+              << std::setw(20) << "replacement (us)" << std::endl;
+
+    for (int capacity : capacities) {
+        double without = time_learn(capacity, false, memory_size, calls);
+        double with = time_learn(capacity, true, memory_size, calls);
+        std::cout << std::setw(12) << capacity
+                  << std::setw(20) << std::fixed << std::setprecision(3) << without
+                  << std::setw(20) << std::fixed << std::setprecision(3) << with << std::endl;
+    }
+
+    return 0;
+}
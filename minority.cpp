@@ -381,3 +381,24 @@ for(std::vector<agent>::iterator it=players.begin(); it!=players.end(); it++)
    it->ClearRecords();
 
 }
+
+//.............................................................................
+// Name: ClearScores
+//
+// Sinopsis: Resets the strategy scores of all players keeping their strategies
+//
+// Parameters:
+//           None
+//
+// Return: None
+//        
+// Exceptions:
+//           None
+//
+// ............................................................................
+void minority::ClearScores(void) {
+
+for(std::vector<agent>::iterator it=players.begin(); it!=players.end(); it++)
+   it->ClearScores();
+
+}
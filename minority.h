@@ -105,6 +105,7 @@
 		
 		void Initialize(void);
 		void Clear(void);
+		void ClearScores(void);
 		int Run(void);
 		int RunBidirectional(void);
 
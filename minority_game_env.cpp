@@ -14,10 +14,37 @@
 
 // Single Agent Environment Implementation
 
+// Plays rounds among the traditional agents only (players with skip[i] set
+// sit out), updating their strategy scores. Returns the final memory state.
+static unsigned long run_background_rounds(minority& game, const std::vector<char>& skip,
+                                           unsigned long mu, unsigned long P, long rounds) {
+    int n = game.PlayersSize();
+    for (long round = 0; round < rounds; round++) {
+        unsigned long mu_naive = RNDInteger(P - 1);
+        
+        int A = 0;
+        for (int i = 0; i < n; i++) {
+            if (!skip[i]) A += game.Player(i).Bet(mu, mu_naive);
+        }
+        
+        for (int i = 0; i < n; i++) {
+            if (skip[i]) continue;
+            agent& player = game.Player(i);
+            player.UpdateScore(player.Naive() ? mu_naive : mu, A);
+        }
+        
+        int winning_side = (A > 0) ? 0 : (A < 0) ? 1 : (int)RNDInteger(1);
+        mu = ((mu << 1) | winning_side) & (P - 1);
+    }
+    return mu;
+}
+
 MinorityGameEnv::MinorityGameEnv(int num_players, int memory_size, int num_strategies,
                                 int equilibration_time, int max_episodes, 
-                                int replace_agent_idx, long seed)
-    : num_players(num_players), memory_size(memory_size), num_strategies(num_strategies),
+                                int replace_agent_idx, long seed, int history_capacity)
+    : history(history_capacity), mu(0), P(1UL << memory_size), last_attendance(0),
+      reset_policy(ResetPolicy::FULL),
+      num_players(num_players), memory_size(memory_size), num_strategies(num_strategies),
       equilibration_time(equilibration_time), max_episodes(max_episodes),
       replace_agent_idx(replace_agent_idx), seed(seed),
       current_step(0), rl_agent_score(0.0), rl_agent_wins(0) {
@@ -27,32 +54,52 @@ MinorityGameEnv::MinorityGameEnv(int num_players, int memory_size, int num_strat
     }
     
     non_rl_agent_wins.resize(num_players - 1, 0);  // All agents except the RL agent
+    non_rl_wins_sum = 0;
+    non_rl_wins_sq_sum = 0;
 }
 
 MinorityGameEnv::~MinorityGameEnv() = default;
 
 Observation MinorityGameEnv::reset() {
-    // Create new game instance
-    minority_options opts;
-    opts.number_of_players = num_players;
-    opts.memory = memory_size;
-    opts.number_of_strategies = num_strategies;
-    opts.teq = equilibration_time;
-    opts.seed = seed;
-    
-    game = std::make_unique<minority>(opts);
+    bool rebuild = !game || reset_policy == ResetPolicy::FULL;
+    
+    if (rebuild) {
+        // Create new game instance
+        minority_options opts;
+        opts.number_of_players = num_players;
+        opts.memory = memory_size;
+        opts.number_of_strategies = num_strategies;
+        opts.teq = equilibration_time;
+        opts.seed = seed;
+        
+        game = std::make_unique<minority>(opts);
+    } else if (reset_policy == ResetPolicy::KEEP_AGENTS) {
+        // Same population, fresh strategy scores
+        game->ClearScores();
+    }
     
-    // Reset state
-    history.clear();
+    // Reset episode state
     current_step = 0;
     rl_agent_score = 0.0;
     rl_agent_wins = 0;
     
     std::fill(non_rl_agent_wins.begin(), non_rl_agent_wins.end(), 0);
-    
-    // Initialize history with random outcomes
-    for (int i = 0; i < memory_size; i++) {
-        history.push_back(RNDInteger(1));  // 0 or 1
+    non_rl_wins_sum = 0;
+    non_rl_wins_sq_sum = 0;
+    
+    // A continued game keeps its memory state
+    if (rebuild || reset_policy != ResetPolicy::CONTINUE) {
+        history.clear();
+        mu = 0;
+        last_attendance = 0;
+        
+        // Initialize history with random outcomes
+        for (int i = 0; i < memory_size; i++) {
+            push_outcome(RNDInteger(1));  // 0 or 1
+        }
+        
+        // Bring the background population to its stationary state
+        equilibrate();
     }
     
     return get_observation();
@@ -66,38 +113,24 @@ std::tuple<Observation, double, bool, EnvInfo> MinorityGameEnv::step(int action)
     // Convert RL action (0/1) to game bet (-1/+1)
     int rl_bet = (action == 1) ? 1 : -1;
     
-    // Get current memory state for traditional agents
-    unsigned long P = 1UL << memory_size;
-    unsigned long mu = 0;
-    if (!history.empty()) {
-        // Convert history to memory state
-        for (int i = 0; i < std::min(memory_size, (int)history.size()); i++) {
-            int idx = history.size() - memory_size + i;
-            if (idx >= 0) {
-                mu += history[idx] * (1UL << i);
-            }
-        }
-        mu = mu % P;
-    }
-    
+    // Current memory state (mu) is maintained incrementally by push_outcome
     unsigned long mu_naive = RNDInteger(P - 1);  // Random state for naive agents
     
     // Collect bets from all agents
     int total_attendance = 0;
-    std::vector<int> agent_bets;
+    std::vector<int> agent_bets(num_players);
     
-    std::vector<agent> players = game->GetPlayers();
-    for (int i = 0; i < (int)players.size(); i++) {
+    for (int i = 0; i < num_players; i++) {
         int bet;
         if (i == replace_agent_idx) {
             // Use RL agent's action
             bet = rl_bet;
         } else {
             // Use traditional agent's strategy
-            bet = players[i].Bet(mu, mu_naive);
+            bet = game->Player(i).Bet(mu, mu_naive);
         }
         
-        agent_bets.push_back(bet);
+        agent_bets[i] = bet;
         total_attendance += bet;
     }
     
@@ -128,28 +161,29 @@ std::tuple<Observation, double, bool, EnvInfo> MinorityGameEnv::step(int action)
     
     rl_agent_score += reward;
     
+    // Record wins and update scores of traditional agents
     int non_rl_idx = 0;
-    for (int i = 0; i < (int)players.size(); i++) {
-        if (i != replace_agent_idx) {
-            // Check if this non-RL agent won
-            int agent_action = (agent_bets[i] == 1) ? 1 : 0;
-            if (agent_action == winning_side) {
-                non_rl_agent_wins[non_rl_idx]++;
-            }
-            non_rl_idx++;
-        }
-    }
-    
-    // Update traditional agent scores
-    for (int i = 0; i < (int)players.size(); i++) {
-        if (i != replace_agent_idx) {
-            unsigned long memory_state = players[i].Naive() ? mu_naive : mu;
-            players[i].UpdateScore(memory_state, total_attendance);
+    for (int i = 0; i < num_players; i++) {
+        if (i == replace_agent_idx) continue;
+        
+        int agent_action = (agent_bets[i] == 1) ? 1 : 0;
+        if (agent_action == winning_side) {
+            // (w+1)^2 - w^2 = 2w+1 keeps the sum of squares current
+            non_rl_wins_sq_sum += 2LL * non_rl_agent_wins[non_rl_idx] + 1;
+            non_rl_wins_sum++;
+            non_rl_agent_wins[non_rl_idx]++;
         }
+        non_rl_idx++;
+        
+        agent& player = game->Player(i);
+        unsigned long memory_state = player.Naive() ? mu_naive : mu;
+        player.UpdateScore(memory_state, total_attendance);
     }
     
     // Update history with the winning_side calculated above
-    history.push_back(winning_side);
+    unsigned long played_mu = mu;
+    push_outcome(winning_side);
+    last_attendance = total_attendance;
     
     // Update step counter
     current_step++;
@@ -169,10 +203,14 @@ std::tuple<Observation, double, bool, EnvInfo> MinorityGameEnv::step(int action)
     info.rl_agent_wins = rl_agent_wins;
     info.win_rate = (current_step > 0) ? (double)rl_agent_wins / current_step : 0.0;
     info.agent_bets = agent_bets;
-    info.memory_state = mu;
+    info.memory_state = played_mu;
     
-    info.non_rl_agent_wins = non_rl_agent_wins;
-    info.non_rl_win_rates = get_non_rl_win_rates();
+    info.non_rl_avg_win_rate = get_non_rl_avg_win_rate();
+    info.non_rl_std_win_rate = get_non_rl_std_win_rate();
+    if (terminated) {
+        info.non_rl_agent_wins = non_rl_agent_wins;
+        info.non_rl_win_rates = get_non_rl_win_rates();
+    }
     
     return std::make_tuple(observation, reward, terminated, info);
 }
@@ -196,11 +234,7 @@ double MinorityGameEnv::get_non_rl_avg_win_rate() const {
         return 0.0;
     }
     
-    double sum = 0.0;
-    for (int wins : non_rl_agent_wins) {
-        sum += (double)wins / current_step;
-    }
-    return sum / non_rl_agent_wins.size();
+    return (double)non_rl_wins_sum / ((double)non_rl_agent_wins.size() * current_step);
 }
 
 double MinorityGameEnv::get_non_rl_std_win_rate() const {
@@ -208,30 +242,46 @@ double MinorityGameEnv::get_non_rl_std_win_rate() const {
         return 0.0;
     }
     
-    double avg = get_non_rl_avg_win_rate();
-    double sum_sq_diff = 0.0;
+    // Population variance of the win rates from the running sums
+    double n = non_rl_agent_wins.size();
+    double mean_wins = non_rl_wins_sum / n;
+    double var_wins = non_rl_wins_sq_sum / n - mean_wins * mean_wins;
+    return std::sqrt(std::max(0.0, var_wins)) / current_step;
+}
+
+void MinorityGameEnv::equilibrate() {
+    long rounds = game->StationaryTime();  // teq * P
+    if (rounds <= 0) return;
     
-    for (int wins : non_rl_agent_wins) {
-        double win_rate = (double)wins / current_step;
-        double diff = win_rate - avg;
-        sum_sq_diff += diff * diff;
+    std::vector<char> skip(num_players, 0);
+    if (replace_agent_idx >= 0 && replace_agent_idx < num_players) {
+        skip[replace_agent_idx] = 1;
     }
     
-    return std::sqrt(sum_sq_diff / non_rl_agent_wins.size());
+    unsigned long final_mu = run_background_rounds(*game, skip, mu, P, rounds);
+    
+    // Restart the render history from the equilibrated memory state
+    history.clear();
+    mu = 0;
+    for (int i = memory_size - 1; i >= 0; i--) {
+        push_outcome((final_mu >> i) & 1UL);
+    }
+}
+
+void MinorityGameEnv::push_outcome(int outcome) {
+    mu = ((mu << 1) | outcome) & (P - 1);
+    history.push(outcome);
 }
 
 Observation MinorityGameEnv::get_observation() const {
-    Observation obs(memory_size);
-    obs.update(history, memory_size);
-    return obs;
+    return Observation(memory_size, mu, last_attendance);
 }
 
 void MinorityGameEnv::render() const {
     std::cout << "Step: " << current_step << std::endl;
-    std::cout << "History (last 10): ";
-    int start = std::max(0, (int)history.size() - 10);
-    for (int i = start; i < (int)history.size(); i++) {
-        std::cout << history[i] << " ";
+    std::cout << "History (last " << history.size() << "): ";
+    for (int outcome : history.to_vector()) {
+        std::cout << outcome << " ";
     }
     std::cout << std::endl;
     std::cout << "RL Agent Score: " << rl_agent_score << std::endl;
@@ -246,8 +296,11 @@ void MinorityGameEnv::render() const {
 MultiAgentMinorityGameEnv::MultiAgentMinorityGameEnv(int num_players, int num_rl_agents,
                                                    int memory_size, int num_strategies,
                                                    int equilibration_time, int max_episodes,
-                                                   long seed)
-    : num_players(num_players), num_rl_agents(num_rl_agents), memory_size(memory_size),
+                                                   long seed, int history_capacity,
+                                                   bool random_rl_positions)
+    : history(history_capacity), mu(0), P(1UL << memory_size), last_attendance(0),
+      reset_policy(ResetPolicy::FULL),
+      num_players(num_players), num_rl_agents(num_rl_agents), memory_size(memory_size),
       num_strategies(num_strategies), equilibration_time(equilibration_time),
       max_episodes(max_episodes), seed(seed), current_step(0) {
     
@@ -255,43 +308,95 @@ MultiAgentMinorityGameEnv::MultiAgentMinorityGameEnv(int num_players, int num_rl
         RNDInit(seed);
     }
     
-    // RL agent indices (replace first num_rl_agents traditional agents)
-    rl_agent_indices.clear();
-    for (int i = 0; i < num_rl_agents; i++) {
-        rl_agent_indices.push_back(i);
+    if (num_rl_agents < 0 || num_rl_agents > num_players) {
+        throw std::invalid_argument("Number of RL agents must be between 0 and " +
+                                  std::to_string(num_players));
+    }
+    
+    // RL agent indices: the first num_rl_agents players, or a random subset
+    std::vector<int> positions(num_players);
+    std::iota(positions.begin(), positions.end(), 0);
+    if (random_rl_positions) {
+        // Partial Fisher-Yates shuffle, O(num_players)
+        for (int i = 0; i < num_rl_agents; i++) {
+            int j = i + RNDInteger(num_players - 1 - i);
+            std::swap(positions[i], positions[j]);
+        }
     }
+    positions.resize(num_rl_agents);
+    set_rl_agent_indices(positions);
     
     // Initialize score vectors
     rl_agent_scores.resize(num_rl_agents, 0.0);
     rl_agent_wins.resize(num_rl_agents, 0);
     
     non_rl_agent_wins.resize(num_players - num_rl_agents, 0);
+    non_rl_wins_sum = 0;
+    non_rl_wins_sq_sum = 0;
 }
 
 MultiAgentMinorityGameEnv::~MultiAgentMinorityGameEnv() = default;
 
-std::vector<Observation> MultiAgentMinorityGameEnv::reset() {
-    // Create new game instance
-    minority_options opts;
-    opts.number_of_players = num_players;
-    opts.memory = memory_size;
-    opts.number_of_strategies = num_strategies;
-    opts.teq = equilibration_time;
-    opts.seed = seed;
+void MultiAgentMinorityGameEnv::set_rl_agent_indices(const std::vector<int>& indices) {
+    if ((int)indices.size() != num_rl_agents) {
+        throw std::invalid_argument("Expected " + std::to_string(num_rl_agents) +
+                                  " RL agent positions, got " + std::to_string(indices.size()));
+    }
+    
+    std::vector<int> roles(num_players, -1);
+    for (int rl_idx = 0; rl_idx < num_rl_agents; rl_idx++) {
+        int player = indices[rl_idx];
+        if (player < 0 || player >= num_players || roles[player] != -1) {
+            throw std::invalid_argument("Invalid or duplicate RL agent position: " +
+                                      std::to_string(player));
+        }
+        roles[player] = rl_idx;
+    }
     
-    game = std::make_unique<minority>(opts);
+    rl_agent_indices = indices;
+    player_roles = std::move(roles);
+}
+
+std::vector<Observation> MultiAgentMinorityGameEnv::reset() {
+    bool rebuild = !game || reset_policy == ResetPolicy::FULL;
+    
+    if (rebuild) {
+        // Create new game instance
+        minority_options opts;
+        opts.number_of_players = num_players;
+        opts.memory = memory_size;
+        opts.number_of_strategies = num_strategies;
+        opts.teq = equilibration_time;
+        opts.seed = seed;
+        
+        game = std::make_unique<minority>(opts);
+    } else if (reset_policy == ResetPolicy::KEEP_AGENTS) {
+        // Same population, fresh strategy scores
+        game->ClearScores();
+    }
     
-    // Reset state
-    history.clear();
+    // Reset episode state
     current_step = 0;
     std::fill(rl_agent_scores.begin(), rl_agent_scores.end(), 0.0);
     std::fill(rl_agent_wins.begin(), rl_agent_wins.end(), 0);
     
     std::fill(non_rl_agent_wins.begin(), non_rl_agent_wins.end(), 0);
-    
-    // Initialize history with random outcomes
-    for (int i = 0; i < memory_size; i++) {
-        history.push_back(RNDInteger(1));
+    non_rl_wins_sum = 0;
+    non_rl_wins_sq_sum = 0;
+    
+    // A continued game keeps its memory state
+    if (rebuild || reset_policy != ResetPolicy::CONTINUE) {
+        history.clear();
+        mu = 0;
+        last_attendance = 0;
+        
+        // Initialize history with random outcomes
+        for (int i = 0; i < memory_size; i++) {
+            push_outcome(RNDInteger(1));
+        }
+        
+        // Bring the background population to its stationary state
+        equilibrate();
     }
     
     // Get initial observations for all RL agents (same observation for all)
@@ -311,45 +416,25 @@ MultiAgentMinorityGameEnv::step(const std::vector<int>& actions) {
                                   " actions, got " + std::to_string(actions.size()));
     }
     
-    // Convert actions to bets
-    std::vector<int> rl_bets;
-    for (int action : actions) {
-        rl_bets.push_back((action == 1) ? 1 : -1);
-    }
-    
-    // Get memory state
-    unsigned long P = 1UL << memory_size;
-    unsigned long mu = 0;
-    if (!history.empty()) {
-        for (int i = 0; i < std::min(memory_size, (int)history.size()); i++) {
-            int idx = history.size() - memory_size + i;
-            if (idx >= 0) {
-                mu += history[idx] * (1UL << i);
-            }
-        }
-        mu = mu % P;
-    }
-    
+    // Current memory state (mu) is maintained incrementally by push_outcome
     unsigned long mu_naive = RNDInteger(P - 1);
     
-    // Collect all bets
+    // Collect all bets, looking up each player's role in O(1)
     int total_attendance = 0;
-    std::vector<int> agent_bets;
+    std::vector<int> agent_bets(num_players);
     
-    std::vector<agent> players = game->GetPlayers();
-    for (int i = 0; i < (int)players.size(); i++) {
+    for (int i = 0; i < num_players; i++) {
+        int role = player_roles[i];
         int bet;
-        auto it = std::find(rl_agent_indices.begin(), rl_agent_indices.end(), i);
-        if (it != rl_agent_indices.end()) {
+        if (role >= 0) {
             // Use RL agent's action
-            int rl_idx = std::distance(rl_agent_indices.begin(), it);
-            bet = rl_bets[rl_idx];
+            bet = (actions[role] == 1) ? 1 : -1;
         } else {
             // Use traditional agent's strategy
-            bet = players[i].Bet(mu, mu_naive);
+            bet = game->Player(i).Bet(mu, mu_naive);
         }
         
-        agent_bets.push_back(bet);
+        agent_bets[i] = bet;
         total_attendance += bet;
     }
     
@@ -366,20 +451,28 @@ MultiAgentMinorityGameEnv::step(const std::vector<int>& actions) {
         winning_side = RNDInteger(1);
     }
     
+    // Record wins and update scores of traditional agents
     int non_rl_idx = 0;
-    for (int i = 0; i < (int)players.size(); i++) {
-        if (std::find(rl_agent_indices.begin(), rl_agent_indices.end(), i) == rl_agent_indices.end()) {
-            // This is a non-RL agent
-            int agent_action = (agent_bets[i] == 1) ? 1 : 0;
-            if (agent_action == winning_side) {
-                non_rl_agent_wins[non_rl_idx]++;
-            }
-            non_rl_idx++;
+    for (int i = 0; i < num_players; i++) {
+        if (player_roles[i] >= 0) continue;
+        
+        int agent_action = (agent_bets[i] == 1) ? 1 : 0;
+        if (agent_action == winning_side) {
+            // (w+1)^2 - w^2 = 2w+1 keeps the sum of squares current
+            non_rl_wins_sq_sum += 2LL * non_rl_agent_wins[non_rl_idx] + 1;
+            non_rl_wins_sum++;
+            non_rl_agent_wins[non_rl_idx]++;
         }
+        non_rl_idx++;
+        
+        agent& player = game->Player(i);
+        unsigned long memory_state = player.Naive() ? mu_naive : mu;
+        player.UpdateScore(memory_state, total_attendance);
     }
     
     // Calculate rewards for RL agents using the SAME winning_side
-    std::vector<double> rewards;
+    double attendance_penalty = std::abs(total_attendance) / (double)num_players;
+    std::vector<double> rewards(num_rl_agents);
     for (int i = 0; i < num_rl_agents; i++) {
         double reward;
         if (actions[i] == winning_side) {
@@ -390,23 +483,16 @@ MultiAgentMinorityGameEnv::step(const std::vector<int>& actions) {
         }
         
         // Add attendance penalty
-        double attendance_penalty = std::abs(total_attendance) / (double)num_players;
         reward -= attendance_penalty * 0.1;
         
         rl_agent_scores[i] += reward;
-        rewards.push_back(reward);
-    }
-    
-    // Update traditional agents
-    for (int i = 0; i < (int)players.size(); i++) {
-        if (std::find(rl_agent_indices.begin(), rl_agent_indices.end(), i) == rl_agent_indices.end()) {
-            unsigned long memory_state = players[i].Naive() ? mu_naive : mu;
-            players[i].UpdateScore(memory_state, total_attendance);
-        }
+        rewards[i] = reward;
     }
     
     // Update history and step
-    history.push_back(winning_side);
+    unsigned long played_mu = mu;
+    push_outcome(winning_side);
+    last_attendance = total_attendance;
     current_step++;
     
     // Check termination
@@ -425,10 +511,14 @@ MultiAgentMinorityGameEnv::step(const std::vector<int>& actions) {
     info.total_attendance = total_attendance;
     info.winning_side = winning_side;
     info.agent_bets = agent_bets;
-    info.memory_state = mu;
+    info.memory_state = played_mu;
     
-    info.non_rl_agent_wins = non_rl_agent_wins;
-    info.non_rl_win_rates = get_non_rl_win_rates();  // This now properly initializes the vector
+    info.non_rl_avg_win_rate = get_non_rl_avg_win_rate();
+    info.non_rl_std_win_rate = get_non_rl_std_win_rate();
+    if (terminated) {
+        info.non_rl_agent_wins = non_rl_agent_wins;
+        info.non_rl_win_rates = get_non_rl_win_rates();
+    }
     
     return std::make_tuple(observations, rewards, terminated, info);
 }
@@ -450,11 +540,7 @@ double MultiAgentMinorityGameEnv::get_non_rl_avg_win_rate() const {
         return 0.0;
     }
     
-    double sum = 0.0;
-    for (int wins : non_rl_agent_wins) {
-        sum += (double)wins / current_step;
-    }
-    return sum / non_rl_agent_wins.size();
+    return (double)non_rl_wins_sum / ((double)non_rl_agent_wins.size() * current_step);
 }
 
 double MultiAgentMinorityGameEnv::get_non_rl_std_win_rate() const {
@@ -462,30 +548,46 @@ double MultiAgentMinorityGameEnv::get_non_rl_std_win_rate() const {
         return 0.0;
     }
     
-    double avg = get_non_rl_avg_win_rate();
-    double sum_sq_diff = 0.0;
+    // Population variance of the win rates from the running sums
+    double n = non_rl_agent_wins.size();
+    double mean_wins = non_rl_wins_sum / n;
+    double var_wins = non_rl_wins_sq_sum / n - mean_wins * mean_wins;
+    return std::sqrt(std::max(0.0, var_wins)) / current_step;
+}
+
+void MultiAgentMinorityGameEnv::equilibrate() {
+    long rounds = game->StationaryTime();  // teq * P
+    if (rounds <= 0) return;
     
-    for (int wins : non_rl_agent_wins) {
-        double win_rate = (double)wins / current_step;
-        double diff = win_rate - avg;
-        sum_sq_diff += diff * diff;
+    std::vector<char> skip(num_players, 0);
+    for (int player : rl_agent_indices) {
+        skip[player] = 1;
     }
     
-    return std::sqrt(sum_sq_diff / non_rl_agent_wins.size());
+    unsigned long final_mu = run_background_rounds(*game, skip, mu, P, rounds);
+    
+    // Restart the render history from the equilibrated memory state
+    history.clear();
+    mu = 0;
+    for (int i = memory_size - 1; i >= 0; i--) {
+        push_outcome((final_mu >> i) & 1UL);
+    }
+}
+
+void MultiAgentMinorityGameEnv::push_outcome(int outcome) {
+    mu = ((mu << 1) | outcome) & (P - 1);
+    history.push(outcome);
 }
 
 Observation MultiAgentMinorityGameEnv::get_observation() const {
-    Observation obs(memory_size);
-    obs.update(history, memory_size);
-    return obs;
+    return Observation(memory_size, mu, last_attendance);
 }
 
 void MultiAgentMinorityGameEnv::render() const {
     std::cout << "Step: " << current_step << std::endl;
-    std::cout << "History (last 10): ";
-    int start = std::max(0, (int)history.size() - 10);
-    for (int i = start; i < (int)history.size(); i++) {
-        std::cout << history[i] << " ";
+    std::cout << "History (last " << history.size() << "): ";
+    for (int outcome : history.to_vector()) {
+        std::cout << outcome << " ";
     }
     std::cout << std::endl;
     std::cout << "RL Agent Scores: ";
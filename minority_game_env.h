@@ -12,6 +12,7 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <algorithm>
 #include "minority.h"
 #include "agent.h"
 #include "configuration.h"
@@ -29,44 +30,111 @@ struct EnvInfo {
     double win_rate;
     std::vector<int> agent_bets;
     unsigned long memory_state;
-    std::vector<int> non_rl_agent_wins;  // Win count for each non-RL agent
-    std::vector<double> non_rl_win_rates; // Win rate for each non-RL agent
+    double non_rl_avg_win_rate;
+    double non_rl_std_win_rate;
+    std::vector<int> non_rl_agent_wins;  // Win count for each non-RL agent (final step only)
+    std::vector<double> non_rl_win_rates; // Win rate for each non-RL agent (final step only)
     
     EnvInfo() : step(0), total_attendance(0), winning_side(0), 
                 rl_agent_score(0.0), rl_agent_wins(0), win_rate(0.0), 
-                memory_state(0) {}
+                memory_state(0), non_rl_avg_win_rate(0.0), non_rl_std_win_rate(0.0) {}
 };
 
-// Observation space for RL agents
+// Observation space for RL agents. The last memory_size outcomes are packed
+// into mu (most recent outcome in bit 0, as in minority::Run), so an
+// observation is passed by value without any heap allocation.
 struct Observation {
-    std::vector<int> history;  // Last memory_size outcomes
+    unsigned long mu;   // Packed history of the last memory_size outcomes
+    int memory_size;
+    int attendance;     // Total attendance of the previous round (extra feature)
+    
+    Observation(int memory_size = 0, unsigned long mu = 0, int attendance = 0)
+        : mu(mu), memory_size(memory_size), attendance(attendance) {}
     
-    Observation(int memory_size) : history(memory_size, 0) {}
+    // Outcome lag rounds ago (lag 0 is the most recent round)
+    int outcome(int lag) const { return (mu >> lag) & 1UL; }
+    
+    // Unpacked history, oldest outcome first
+    std::vector<int> to_vector() const {
+        std::vector<int> history(memory_size);
+        for (int i = 0; i < memory_size; i++) {
+            history[memory_size - 1 - i] = outcome(i);
+        }
+        return history;
+    }
+    
+    // Pack an unpacked history (oldest outcome first)
+    static Observation from_vector(const std::vector<int>& history) {
+        Observation obs(history.size());
+        for (int outcome : history) {
+            obs.mu = (obs.mu << 1) | (outcome != 0);
+        }
+        return obs;
+    }
     
+    // Pack the last memory_size outcomes of a full game history,
+    // padding with zeros if not enough history
     void update(const std::vector<int>& game_history, int memory_size) {
-        history.clear();
-        if ((int)game_history.size() < memory_size) {
-            // Pad with zeros if not enough history
-            for (int i = 0; i < memory_size - (int)game_history.size(); i++) {
-                history.push_back(0);
-            }
-            for (int outcome : game_history) {
-                history.push_back(outcome);
-            }
-        } else {
-            // Take last memory_size outcomes
-            for (int i = game_history.size() - memory_size; i < (int)game_history.size(); i++) {
-                history.push_back(game_history[i]);
-            }
+        this->memory_size = memory_size;
+        mu = 0;
+        int start = std::max(0, (int)game_history.size() - memory_size);
+        for (int i = start; i < (int)game_history.size(); i++) {
+            mu = (mu << 1) | (game_history[i] != 0);
         }
     }
 };
 
+// Fixed-capacity ring buffer of recent outcomes, kept for render/export only.
+// The game itself runs on the packed memory state mu.
+class OutcomeHistory {
+private:
+    std::vector<int> buffer;
+    int head;   // Next write position
+    int count;  // Number of valid entries
+    
+public:
+    OutcomeHistory(int capacity = 0) : buffer(capacity, 0), head(0), count(0) {}
+    
+    void clear() { head = 0; count = 0; }
+    
+    void push(int outcome) {
+        if (buffer.empty()) return;
+        buffer[head] = outcome;
+        head = (head + 1) % (int)buffer.size();
+        if (count < (int)buffer.size()) count++;
+    }
+    
+    int capacity() const { return buffer.size(); }
+    int size() const { return count; }
+    
+    // Outcomes currently held, oldest first
+    std::vector<int> to_vector() const {
+        std::vector<int> out;
+        out.reserve(count);
+        int start = (head - count + (int)buffer.size()) % std::max(1, (int)buffer.size());
+        for (int i = 0; i < count; i++) {
+            out.push_back(buffer[(start + i) % buffer.size()]);
+        }
+        return out;
+    }
+};
+
+// What reset() does with the background population between episodes
+enum class ResetPolicy {
+    FULL,         // Build a new game, re-drawing all strategies
+    KEEP_AGENTS,  // Keep the same agents and strategies, clear strategy scores
+    CONTINUE      // Keep agents, scores and memory state from the previous episode
+};
+
 // Single agent RL environment
 class MinorityGameEnv {
 private:
     std::unique_ptr<minority> game;
-    std::vector<int> history;
+    OutcomeHistory history;
+    unsigned long mu;  // Rolling memory state, most recent outcome in bit 0
+    unsigned long P;   // Number of memory states, 2^memory_size
+    int last_attendance;
+    ResetPolicy reset_policy;
     
     // Environment parameters
     int num_players;
@@ -81,10 +149,18 @@ private:
     int rl_agent_wins;
     
     std::vector<int> non_rl_agent_wins;  // Track wins for each non-RL agent
+    long long non_rl_wins_sum;           // Running sum of non_rl_agent_wins
+    long long non_rl_wins_sq_sum;        // Running sum of squared non_rl_agent_wins
     
     // Calculate reward for RL agent
     double calculate_reward(int rl_action, int total_attendance);
     
+    // Shift an outcome into the memory state and the render history
+    void push_outcome(int outcome);
+    
+    // Run the traditional agents alone for teq * P rounds
+    void equilibrate();
+    
 public:
     MinorityGameEnv(int num_players = 101,
                    int memory_size = 3,
@@ -92,7 +168,8 @@ public:
                    int equilibration_time = 500,
                    int max_episodes = 10000,
                    int replace_agent_idx = 0,
-                   long seed = -1);
+                   long seed = -1,
+                   int history_capacity = 10);
     
     ~MinorityGameEnv();
     
@@ -106,8 +183,12 @@ public:
     int get_current_step() const { return current_step; }
     double get_rl_agent_score() const { return rl_agent_score; }
     int get_rl_agent_wins() const { return rl_agent_wins; }
+    unsigned long get_memory_state() const { return mu; }
+    ResetPolicy get_reset_policy() const { return reset_policy; }
+    void set_reset_policy(ResetPolicy policy) { reset_policy = policy; }
+    std::vector<int> get_history() const { return history.to_vector(); }
     
-    std::vector<int> get_non_rl_agent_wins() const { return non_rl_agent_wins; }
+    const std::vector<int>& get_non_rl_agent_wins() const { return non_rl_agent_wins; }
     std::vector<double> get_non_rl_win_rates() const;
     double get_non_rl_avg_win_rate() const;
     double get_non_rl_std_win_rate() const;
@@ -121,7 +202,11 @@ public:
 class MultiAgentMinorityGameEnv {
 private:
     std::unique_ptr<minority> game;
-    std::vector<int> history;
+    OutcomeHistory history;
+    unsigned long mu;  // Rolling memory state, most recent outcome in bit 0
+    unsigned long P;   // Number of memory states, 2^memory_size
+    int last_attendance;
+    ResetPolicy reset_policy;
     std::vector<double> rl_agent_scores;
     std::vector<int> rl_agent_wins;
     
@@ -132,11 +217,20 @@ private:
     int num_strategies;
     int equilibration_time;
     int max_episodes;
-    std::vector<int> rl_agent_indices;
+    std::vector<int> rl_agent_indices;  // Player position of each RL agent
+    std::vector<int> player_roles;      // RL agent index of each player, or -1
     long seed;
     int current_step;
     
     std::vector<int> non_rl_agent_wins;  // Track wins for each non-RL agent
+    long long non_rl_wins_sum;           // Running sum of non_rl_agent_wins
+    long long non_rl_wins_sq_sum;        // Running sum of squared non_rl_agent_wins
+    
+    // Shift an outcome into the memory state and the render history
+    void push_outcome(int outcome);
+    
+    // Run the traditional agents alone for teq * P rounds
+    void equilibrate();
     
 public:
     MultiAgentMinorityGameEnv(int num_players = 101,
@@ -145,7 +239,9 @@ public:
                              int num_strategies = 2,
                              int equilibration_time = 500,
                              int max_episodes = 10000,
-                             long seed = -1);
+                             long seed = -1,
+                             int history_capacity = 10,
+                             bool random_rl_positions = false);
     
     ~MultiAgentMinorityGameEnv();
     
@@ -153,15 +249,24 @@ public:
     std::vector<Observation> reset();
     std::tuple<std::vector<Observation>, std::vector<double>, bool, EnvInfo> step(const std::vector<int>& actions);
     
+    // Place the RL agents at arbitrary player positions (one per RL agent)
+    void set_rl_agent_indices(const std::vector<int>& indices);
+    
     // Getters
     int get_action_space_size() const { return 2; }
     int get_observation_space_size() const { return memory_size; }
     int get_num_rl_agents() const { return num_rl_agents; }
+    const std::vector<int>& get_rl_agent_indices() const { return rl_agent_indices; }
+    int get_player_role(int player) const { return player_roles[player]; }
     int get_current_step() const { return current_step; }
     const std::vector<double>& get_rl_agent_scores() const { return rl_agent_scores; }
     const std::vector<int>& get_rl_agent_wins() const { return rl_agent_wins; }
+    unsigned long get_memory_state() const { return mu; }
+    ResetPolicy get_reset_policy() const { return reset_policy; }
+    void set_reset_policy(ResetPolicy policy) { reset_policy = policy; }
+    std::vector<int> get_history() const { return history.to_vector(); }
     
-    std::vector<int> get_non_rl_agent_wins() const { return non_rl_agent_wins; }
+    const std::vector<int>& get_non_rl_agent_wins() const { return non_rl_agent_wins; }
     std::vector<double> get_non_rl_win_rates() const;
     double get_non_rl_avg_win_rate() const;
     double get_non_rl_std_win_rate() const;
@@ -127,7 +127,14 @@ std::string ModelPersistenceManager::generate_model_filename(const std::string&
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
+    // std::localtime shares one static buffer between threads
+    std::tm local_time{};
+#ifdef _WIN32
+    localtime_s(&local_time, &time_t);
+#else
+    localtime_r(&time_t, &local_time);
+#endif
+    ss << std::put_time(&local_time, "%Y%m%d_%H%M%S");
     
     std::string filename = agent_type + "_model_" + ss.str();
     if (!suffix.empty()) {
@@ -284,9 +291,21 @@ void TrainingCheckpointManager::save_checkpoint(RLAgent* agent, const TrainingMe
     // Save agent model
     agent->save_model(checkpoint_path);
     
-    // Save training metrics
-    std::string metrics_path = exp_dir + "metrics_episode_" + std::to_string(episode) + ".csv";
-    metrics.save_to_file(metrics_path);
+    // Append the episodes since the previous checkpoint to the experiment's
+    // metrics stream; rows already on disk are never rewritten
+    std::unique_ptr<MetricsStreamWriter>& writer = metrics_writers[experiment_name];
+    if (!writer) {
+        writer = std::make_unique<MetricsStreamWriter>(
+            exp_dir + "metrics.csv",
+            TrainingMetrics::columns(),
+            checkpoint_frequency, true);
+    }
+    for (size_t e = writer->get_row_count(); e < metrics.episode_rewards.size(); e++) {
+        writer->add_row({metrics.episode_rewards[e], metrics.win_rates[e],
+                         e < metrics.average_rewards.size() ? metrics.average_rewards[e] : 0.0,
+                         e < metrics.episode_lengths.size() ? (double)metrics.episode_lengths[e] : 0.0});
+    }
+    writer->flush(true);
     
     // Save checkpoint info
     std::string info_path = exp_dir + "checkpoint_info_" + std::to_string(episode) + ".txt";
@@ -353,7 +372,7 @@ bool TrainingCheckpointManager::load_latest_checkpoint(std::unique_ptr<RLAgent>&
     }
     
     // Load metrics
-    std::string metrics_path = exp_dir + "metrics_episode_" + std::to_string(start_episode) + ".csv";
+    std::string metrics_path = exp_dir + "metrics.csv";
     try {
         metrics.load_from_file(metrics_path);
     } catch (const std::exception&) {
@@ -402,10 +421,8 @@ void TrainingCheckpointManager::cleanup_old_checkpoints(const std::string& exper
             std::string base_name = checkpoint_path.stem().string();
             std::string episode_str = base_name.substr(base_name.find("episode_"));
             
-            std::string metrics_file = exp_dir + "metrics_" + episode_str + ".csv";
             std::string info_file = exp_dir + "checkpoint_info_" + episode_str + ".txt";
             
-            std::filesystem::remove(metrics_file);
             std::filesystem::remove(info_file);
             
         } catch (const std::filesystem::filesystem_error& e) {
@@ -430,7 +447,8 @@ namespace ModelPersistenceUtils {
         // Check if it starts with a known agent type
         return (first_line == "RandomAgent" || 
                 first_line == "QLearningAgent" || 
-                first_line == "DQNAgent");
+                first_line == "DQNAgent" ||
+                first_line == "NeuralDQNAgent");
     }
     
     std::string sanitize_filename(const std::string& name) {
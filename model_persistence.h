@@ -117,6 +117,9 @@ private:
     int checkpoint_frequency;
     int max_checkpoints;
     
+    // Append-only metrics.csv of each experiment, kept open between checkpoints
+    std::map<std::string, std::unique_ptr<MetricsStreamWriter>> metrics_writers;
+    
 public:
     TrainingCheckpointManager(const std::string& checkpoint_dir = "checkpoints/",
                              int frequency = 100, int max_checkpoints = 5);
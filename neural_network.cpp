@@ -0,0 +1,316 @@
+/***************************************************************************
+                          neural_network.cpp  -  description
+                             -------------------
+    begin                : October 2026
+    email                :
+ ***************************************************************************/
+
+#include "neural_network.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NEURAL_HAVE_AVX2_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// NeuralKernels Implementation
+
+namespace NeuralKernels {
+    // Cache blocking: a BLOCK_K x BLOCK_N tile of B (128 KB) stays in L2
+    // while it is applied to every row of A
+    static const int BLOCK_K = 128;
+    static const int BLOCK_N = 256;
+
+    // y[0..n) += a * x[0..n)
+    static void axpy_scalar(int n, float a, const float* x, float* y) {
+        for (int j = 0; j < n; j++) {
+            y[j] += a * x[j];
+        }
+    }
+
+    static float dot_scalar(int n, const float* x, const float* y) {
+        float sum = 0.0f;
+        for (int j = 0; j < n; j++) {
+            sum += x[j] * y[j];
+        }
+        return sum;
+    }
+
+#ifdef NEURAL_HAVE_AVX2_DISPATCH
+    __attribute__((target("avx2,fma")))
+    static void axpy_avx2(int n, float a, const float* x, float* y) {
+        __m256 va = _mm256_set1_ps(a);
+        int j = 0;
+        for (; j + 8 <= n; j += 8) {
+            __m256 vy = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + j), _mm256_loadu_ps(y + j));
+            _mm256_storeu_ps(y + j, vy);
+        }
+        for (; j < n; j++) {
+            y[j] += a * x[j];
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    static float dot_avx2(int n, const float* x, const float* y) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        int j = 0;
+        for (; j + 16 <= n; j += 16) {
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j), _mm256_loadu_ps(y + j), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j + 8), _mm256_loadu_ps(y + j + 8), acc1);
+        }
+        for (; j + 8 <= n; j += 8) {
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j), _mm256_loadu_ps(y + j), acc0);
+        }
+        acc0 = _mm256_add_ps(acc0, acc1);
+        __m128 lo = _mm256_castps256_ps128(acc0);
+        __m128 hi = _mm256_extractf128_ps(acc0, 1);
+        lo = _mm_add_ps(lo, hi);
+        lo = _mm_hadd_ps(lo, lo);
+        lo = _mm_hadd_ps(lo, lo);
+        float sum = _mm_cvtss_f32(lo);
+        for (; j < n; j++) {
+            sum += x[j] * y[j];
+        }
+        return sum;
+    }
+#endif
+
+    typedef void (*AxpyFn)(int, float, const float*, float*);
+    typedef float (*DotFn)(int, const float*, const float*);
+
+    static bool detect_avx2() {
+#ifdef NEURAL_HAVE_AVX2_DISPATCH
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+        return false;
+#endif
+    }
+
+    static const bool has_avx2 = detect_avx2();
+
+#ifdef NEURAL_HAVE_AVX2_DISPATCH
+    static const AxpyFn axpy = has_avx2 ? axpy_avx2 : axpy_scalar;
+    static const DotFn dot = has_avx2 ? dot_avx2 : dot_scalar;
+#else
+    static const AxpyFn axpy = axpy_scalar;
+    static const DotFn dot = dot_scalar;
+#endif
+
+    bool using_avx2() {
+        return has_avx2;
+    }
+
+    void gemm_nn(int M, int N, int K, const float* A, const float* B, float* C) {
+        for (int k0 = 0; k0 < K; k0 += BLOCK_K) {
+            int k1 = std::min(K, k0 + BLOCK_K);
+            for (int n0 = 0; n0 < N; n0 += BLOCK_N) {
+                int width = std::min(N, n0 + BLOCK_N) - n0;
+                for (int i = 0; i < M; i++) {
+                    float* c_row = C + (size_t)i * N + n0;
+                    for (int k = k0; k < k1; k++) {
+                        float a = A[(size_t)i * K + k];
+                        if (a != 0.0f) {
+                            axpy(width, a, B + (size_t)k * N + n0, c_row);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void gemm_tn(int M, int N, int K, const float* A, const float* B, float* C) {
+        for (int n0 = 0; n0 < N; n0 += BLOCK_N) {
+            int width = std::min(N, n0 + BLOCK_N) - n0;
+            for (int k = 0; k < K; k++) {
+                const float* b_row = B + (size_t)k * N + n0;
+                for (int i = 0; i < M; i++) {
+                    float a = A[(size_t)k * M + i];
+                    if (a != 0.0f) {
+                        axpy(width, a, b_row, C + (size_t)i * N + n0);
+                    }
+                }
+            }
+        }
+    }
+
+    void gemm_nt(int M, int N, int K, const float* A, const float* B, float* C) {
+        for (int i = 0; i < M; i++) {
+            const float* a_row = A + (size_t)i * K;
+            for (int j = 0; j < N; j++) {
+                C[(size_t)i * N + j] += dot(K, a_row, B + (size_t)j * K);
+            }
+        }
+    }
+}
+
+// MLP Implementation
+
+MLP::MLP(const std::vector<int>& layer_sizes, unsigned int seed)
+    : layer_sizes(layer_sizes), adam_steps(0), last_batch(0) {
+    if (layer_sizes.size() < 2) {
+        return;
+    }
+
+    // Lay out all weights and biases in one array
+    size_t offset = 0;
+    for (int l = 0; l < num_layers(); l++) {
+        weight_offsets.push_back(offset);
+        offset += (size_t)layer_sizes[l] * layer_sizes[l + 1];
+        bias_offsets.push_back(offset);
+        offset += layer_sizes[l + 1];
+    }
+
+    parameters.assign(offset, 0.0f);
+    gradients.assign(offset, 0.0f);
+    adam_m.assign(offset, 0.0f);
+    adam_v.assign(offset, 0.0f);
+    activations.resize(layer_sizes.size());
+
+    // He initialization for ReLU layers, zero biases
+    std::mt19937 init_rng(seed);
+    for (int l = 0; l < num_layers(); l++) {
+        std::normal_distribution<float> weight_dist(0.0f, std::sqrt(2.0f / layer_sizes[l]));
+        size_t count = (size_t)layer_sizes[l] * layer_sizes[l + 1];
+        for (size_t i = 0; i < count; i++) {
+            parameters[weight_offsets[l] + i] = weight_dist(init_rng);
+        }
+    }
+}
+
+const float* MLP::forward(const float* input, int batch) {
+    last_batch = batch;
+    return infer(input, batch, activations);
+}
+
+const float* MLP::infer(const float* input, int batch,
+                        std::vector<std::vector<float>>& layers) const {
+    layers.resize(layer_sizes.size());
+    layers[0].assign(input, input + (size_t)batch * input_size());
+
+    for (int l = 0; l < num_layers(); l++) {
+        int in = layer_sizes[l];
+        int out = layer_sizes[l + 1];
+        const float* bias = &parameters[bias_offsets[l]];
+
+        std::vector<float>& y = layers[l + 1];
+        y.resize((size_t)batch * out);
+        for (int b = 0; b < batch; b++) {
+            std::memcpy(&y[(size_t)b * out], bias, out * sizeof(float));
+        }
+
+        NeuralKernels::gemm_nn(batch, out, in, layers[l].data(),
+                               &parameters[weight_offsets[l]], y.data());
+
+        // ReLU on hidden layers, linear output
+        if (l < num_layers() - 1) {
+            for (float& v : y) {
+                v = std::max(0.0f, v);
+            }
+        }
+    }
+
+    return layers.back().data();
+}
+
+void MLP::backward(const float* grad_output) {
+    int batch = last_batch;
+    delta.assign(grad_output, grad_output + (size_t)batch * output_size());
+
+    for (int l = num_layers() - 1; l >= 0; l--) {
+        int in = layer_sizes[l];
+        int out = layer_sizes[l + 1];
+
+        // dW += x^T * delta, db += column sums of delta
+        NeuralKernels::gemm_tn(in, out, batch, activations[l].data(), delta.data(),
+                               &gradients[weight_offsets[l]]);
+        float* bias_grad = &gradients[bias_offsets[l]];
+        for (int b = 0; b < batch; b++) {
+            for (int j = 0; j < out; j++) {
+                bias_grad[j] += delta[(size_t)b * out + j];
+            }
+        }
+
+        if (l == 0) break;
+
+        // delta_prev = delta * W^T, masked by the ReLU of the previous layer
+        delta_prev.assign((size_t)batch * in, 0.0f);
+        NeuralKernels::gemm_nt(batch, in, out, delta.data(),
+                               &parameters[weight_offsets[l]], delta_prev.data());
+        const std::vector<float>& x = activations[l];
+        for (size_t i = 0; i < delta_prev.size(); i++) {
+            if (x[i] <= 0.0f) delta_prev[i] = 0.0f;
+        }
+        delta.swap(delta_prev);
+    }
+}
+
+void MLP::adam_step(float learning_rate, float beta1, float beta2, float epsilon) {
+    adam_steps++;
+    float correction1 = 1.0f - std::pow(beta1, (float)adam_steps);
+    float correction2 = 1.0f - std::pow(beta2, (float)adam_steps);
+    float step_size = learning_rate * std::sqrt(correction2) / correction1;
+
+    for (size_t i = 0; i < parameters.size(); i++) {
+        float g = gradients[i];
+        adam_m[i] = beta1 * adam_m[i] + (1.0f - beta1) * g;
+        adam_v[i] = beta2 * adam_v[i] + (1.0f - beta2) * g * g;
+        parameters[i] -= step_size * adam_m[i] / (std::sqrt(adam_v[i]) + epsilon);
+        gradients[i] = 0.0f;
+    }
+}
+
+void MLP::copy_parameters_from(const MLP& other) {
+    if (other.layer_sizes != layer_sizes) {
+        throw std::invalid_argument("Cannot copy parameters between networks of different shape");
+    }
+    std::memcpy(parameters.data(), other.parameters.data(), parameters.size() * sizeof(float));
+}
+
+void MLP::save_to_stream(std::ostream& out) const {
+    out << "layer_sizes:";
+    for (int size : layer_sizes) {
+        out << " " << size;
+    }
+    out << "\n";
+    out << "parameters: " << parameters.size() << "\n";
+    out << std::setprecision(9);
+    for (size_t i = 0; i < parameters.size(); i++) {
+        out << parameters[i] << ((i + 1) % 16 == 0 ? "\n" : " ");
+    }
+    out << "\n";
+}
+
+void MLP::load_from_stream(std::istream& in) {
+    std::string token;
+    std::vector<int> sizes;
+
+    // layer_sizes: s0 s1 ... (ends at the parameters: token)
+    in >> token;
+    while (in >> token && token != "parameters:") {
+        sizes.push_back(std::stoi(token));
+    }
+    if (sizes != layer_sizes) {
+        throw std::runtime_error("Network shape in file does not match the agent");
+    }
+
+    size_t count;
+    in >> count;
+    if (count != parameters.size()) {
+        throw std::runtime_error("Parameter count in file does not match the agent");
+    }
+    for (size_t i = 0; i < count; i++) {
+        in >> parameters[i];
+    }
+
+    std::fill(adam_m.begin(), adam_m.end(), 0.0f);
+    std::fill(adam_v.begin(), adam_v.end(), 0.0f);
+    std::fill(gradients.begin(), gradients.end(), 0.0f);
+    adam_steps = 0;
+}
@@ -0,0 +1,84 @@
+/***************************************************************************
+                          neural_network.h  -  description
+                             -------------------
+    begin                : October 2026
+    email                :
+ ***************************************************************************/
+
+#ifndef _NEURAL_NETWORK_H_
+#define _NEURAL_NETWORK_H_
+
+#include <vector>
+#include <random>
+#include <iostream>
+
+// Single-precision matrix kernels used by the MLP. All matrices are dense
+// and row-major, and every kernel accumulates into C. The AVX2/FMA versions
+// are selected at run time when the CPU supports them.
+namespace NeuralKernels {
+    // C[M x N] += A[M x K] * B[K x N]
+    void gemm_nn(int M, int N, int K, const float* A, const float* B, float* C);
+    // C[M x N] += A^T * B, with A stored as [K x M] and B as [K x N]
+    void gemm_tn(int M, int N, int K, const float* A, const float* B, float* C);
+    // C[M x N] += A * B^T, with A stored as [M x K] and B as [N x K]
+    void gemm_nt(int M, int N, int K, const float* A, const float* B, float* C);
+
+    bool using_avx2();
+}
+
+// Multi-layer perceptron with ReLU hidden layers and a linear output layer,
+// trained on minibatches with Adam. All weights and biases live in one
+// contiguous array, so copying a network's parameters is a single memcpy.
+class MLP {
+private:
+    std::vector<int> layer_sizes;           // Input, hidden..., output
+    std::vector<size_t> weight_offsets;     // Layer l weights: [in x out]
+    std::vector<size_t> bias_offsets;       // Layer l biases: [out]
+
+    std::vector<float> parameters;
+    std::vector<float> gradients;
+    std::vector<float> adam_m;
+    std::vector<float> adam_v;
+    long adam_steps;
+
+    // Per-layer activations of the last forward pass ([batch x size])
+    std::vector<std::vector<float>> activations;
+    std::vector<float> delta;        // Gradient w.r.t. the current layer output
+    std::vector<float> delta_prev;   // Gradient w.r.t. the previous layer output
+    int last_batch;
+
+    int num_layers() const { return layer_sizes.size() - 1; }
+
+public:
+    MLP(const std::vector<int>& layer_sizes = {}, unsigned int seed = 0);
+
+    // Forward a batch of inputs ([batch x input_size]). Returns the outputs
+    // ([batch x output_size]), valid until the next forward call.
+    const float* forward(const float* input, int batch);
+
+    // Forward pass that leaves the network untouched: the per-layer
+    // activations go to layers, and the returned outputs live there
+    const float* infer(const float* input, int batch,
+                       std::vector<std::vector<float>>& layers) const;
+
+    // Backpropagate the output gradient of the last forward pass and
+    // accumulate parameter gradients
+    void backward(const float* grad_output);
+
+    // Apply and clear the accumulated gradients
+    void adam_step(float learning_rate, float beta1 = 0.9f, float beta2 = 0.999f,
+                   float epsilon = 1e-8f);
+
+    // Copy parameters (not optimizer state) from a network of the same shape
+    void copy_parameters_from(const MLP& other);
+
+    int input_size() const { return layer_sizes.front(); }
+    int output_size() const { return layer_sizes.back(); }
+    const std::vector<int>& get_layer_sizes() const { return layer_sizes; }
+    size_t num_parameters() const { return parameters.size(); }
+
+    void save_to_stream(std::ostream& out) const;
+    void load_from_stream(std::istream& in);
+};
+
+#endif // _NEURAL_NETWORK_H_
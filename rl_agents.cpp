@@ -11,12 +11,209 @@
 #include <sstream>
 #include <stdexcept>
 #include <cmath>
+#include <cstring>
 #include <numeric>
 
+// QTable Implementation
+
+QTable::QTable(int obs_bits, int num_actions)
+    : num_actions(num_actions), dense(obs_bits <= DENSE_MAX_BITS), num_visited(0) {
+    if (dense) {
+        size_t num_states = 1UL << obs_bits;
+        values.assign(num_states * num_actions, 0.0);
+        visited.assign(num_states, 0);
+    }
+}
+
+const double* QTable::find(unsigned long key) const {
+    if (dense) {
+        return (key < visited.size() && visited[key]) ? &values[key * num_actions] : nullptr;
+    }
+    auto it = sparse.find(key);
+    return (it != sparse.end()) ? it->second.data() : nullptr;
+}
+
+void QTable::clear() {
+    std::fill(values.begin(), values.end(), 0.0);
+    std::fill(visited.begin(), visited.end(), 0);
+    num_visited = 0;
+    sparse.clear();
+}
+
+std::vector<unsigned long> QTable::keys() const {
+    std::vector<unsigned long> result;
+    result.reserve(size());
+    if (dense) {
+        for (unsigned long key = 0; key < visited.size(); key++) {
+            if (visited[key]) result.push_back(key);
+        }
+    } else {
+        for (const auto& entry : sparse) {
+            result.push_back(entry.first);
+        }
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+void QTable::copy_from(const QTable& other) {
+    if (dense && other.dense && values.size() == other.values.size()) {
+        std::memcpy(values.data(), other.values.data(), values.size() * sizeof(double));
+        std::memcpy(visited.data(), other.visited.data(), visited.size());
+        num_visited = other.num_visited;
+    } else {
+        *this = other;
+    }
+}
+
+// SharedQTable Implementation
+
+SharedQTable::SharedQTable(int obs_bits, int num_actions, SharedUpdateMode mode)
+    : num_actions(num_actions), mode(mode) {
+    if (obs_bits > QTable::DENSE_MAX_BITS) {
+        throw std::invalid_argument("SharedQTable supports observations of at most " +
+                                    std::to_string(QTable::DENSE_MAX_BITS) + " bits");
+    }
+    
+    num_states = 1UL << obs_bits;
+    values.reset(new std::atomic<double>[num_states * num_actions]);
+    visited.reset(new std::atomic<uint8_t>[num_states]);
+    for (size_t i = 0; i < num_states * num_actions; i++) {
+        values[i].store(0.0, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < num_states; i++) {
+        visited[i].store(0, std::memory_order_relaxed);
+    }
+    
+    if (mode == SharedUpdateMode::STRIPED_LOCKS) {
+        stripes.reset(new Stripe[NUM_STRIPES]);
+    }
+}
+
+int SharedQTable::greedy_action(unsigned long key) {
+    mark_visited(key);
+    const std::atomic<double>* row = &values[key * num_actions];
+    int best = 0;
+    double best_value = row[0].load(std::memory_order_relaxed);
+    for (int a = 1; a < num_actions; a++) {
+        double value = row[a].load(std::memory_order_relaxed);
+        if (value > best_value) {
+            best = a;
+            best_value = value;
+        }
+    }
+    return best;
+}
+
+double SharedQTable::max_value(unsigned long key) {
+    mark_visited(key);
+    const std::atomic<double>* row = &values[key * num_actions];
+    double best_value = row[0].load(std::memory_order_relaxed);
+    for (int a = 1; a < num_actions; a++) {
+        best_value = std::max(best_value, row[a].load(std::memory_order_relaxed));
+    }
+    return best_value;
+}
+
+void SharedQTable::update(unsigned long key, int action, double learning_rate, double target) {
+    mark_visited(key);
+    std::atomic<double>& q = values[key * num_actions + action];
+    
+    if (mode == SharedUpdateMode::STRIPED_LOCKS) {
+        std::lock_guard<std::mutex> guard(stripes[key % NUM_STRIPES].lock);
+        double value = q.load(std::memory_order_relaxed);
+        q.store(value + learning_rate * (target - value), std::memory_order_relaxed);
+    } else {
+        double value = q.load(std::memory_order_relaxed);
+        q.store(value + learning_rate * (target - value), std::memory_order_relaxed);
+    }
+}
+
+void SharedQTable::copy_from(const QTable& table) {
+    for (unsigned long key : table.keys()) {
+        if (key >= num_states) continue;
+        const double* row = table.find(key);
+        for (int a = 0; a < num_actions; a++) {
+            values[key * num_actions + a].store(row[a], std::memory_order_relaxed);
+        }
+        visited[key].store(1, std::memory_order_relaxed);
+    }
+}
+
+void SharedQTable::copy_to(QTable& table) const {
+    for (size_t key = 0; key < num_states; key++) {
+        if (!visited[key].load(std::memory_order_relaxed)) continue;
+        double* row = table.row(key);
+        for (int a = 0; a < num_actions; a++) {
+            row[a] = values[key * num_actions + a].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// ExplorationSchedule Implementation
+
+double ExplorationSchedule::value(long ticks) const {
+    double rate = start;
+    switch (type) {
+        case ScheduleType::EXPONENTIAL:
+            rate = start * std::pow(decay, (double)ticks);
+            break;
+        case ScheduleType::LINEAR:
+            rate = (decay_ticks > 0 && ticks < decay_ticks) ?
+                   start + (minimum - start) * ticks / decay_ticks : minimum;
+            break;
+        case ScheduleType::STEP:
+            rate = start * std::pow(decay, (double)(ticks / std::max(1L, interval)));
+            break;
+    }
+    return std::max(minimum, rate);
+}
+
 // Base RLAgent Implementation
 
 RLAgent::RLAgent(int obs_size, int action_size, unsigned int seed)
-    : observation_space_size(obs_size), action_space_size(action_size), rng(seed) {}
+    : observation_space_size(obs_size), action_space_size(action_size), rng(seed),
+      exploration_ticks(0) {}
+
+void RLAgent::set_exploration_schedule(const ExplorationSchedule& schedule) {
+    exploration = schedule;
+    exploration_ticks = 0;
+    apply_exploration_rate(exploration.value(0));
+}
+
+void RLAgent::restart_exploration(double start) {
+    ExplorationSchedule schedule = exploration;
+    schedule.start = start;
+    set_exploration_schedule(schedule);
+}
+
+void RLAgent::predict_batch(const Observation* observations, int n, int* actions,
+                            bool deterministic) {
+    for (int i = 0; i < n; i++) {
+        actions[i] = predict(observations[i], deterministic);
+    }
+}
+
+void RLAgent::greedy_actions(const Observation* /* observations */, int /* n */,
+                             int* /* actions */) const {
+    throw std::logic_error("Agent has no deterministic policy to query");
+}
+
+void RLAgent::learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                          const Observation* next_obs, const uint8_t* dones, int n) {
+    for (int i = 0; i < n; i++) {
+        learn(obs[i], actions[i], rewards[i], next_obs[i], dones[i] != 0);
+    }
+}
+
+// Index of the largest action value, first one on ties
+template <typename T>
+static inline int greedy_action(const T* q_values, int num_actions) {
+    if (num_actions == 2) {
+        return q_values[1] > q_values[0] ? 1 : 0;
+    }
+    return std::max_element(q_values, q_values + num_actions) - q_values;
+}
 
 // RandomAgent Implementation
 
@@ -66,48 +263,68 @@ QLearningAgent::QLearningAgent(int obs_size, int action_size, double learning_ra
                               double epsilon_min, unsigned int seed)
     : RLAgent(obs_size, action_size, seed), learning_rate(learning_rate),
       epsilon(epsilon), gamma(gamma), epsilon_decay(epsilon_decay),
-      epsilon_min(epsilon_min) {}
-
-std::vector<int> QLearningAgent::obs_to_key(const Observation& observation) const {
-    return observation.history;
+      epsilon_min(epsilon_min), q_table(obs_size, action_size) {
+    exploration = ExplorationSchedule(epsilon, epsilon_decay, epsilon_min);
 }
 
-void QLearningAgent::ensure_q_entry(const std::vector<int>& obs_key) {
-    if (q_table.find(obs_key) == q_table.end()) {
-        q_table[obs_key] = std::vector<double>(action_space_size, 0.0);
-    }
+unsigned long QLearningAgent::obs_to_key(const Observation& observation) const {
+    return observation.mu;
 }
 
 int QLearningAgent::predict(const Observation& observation, bool deterministic) {
-    std::vector<int> obs_key = obs_to_key(observation);
-    ensure_q_entry(obs_key);
+    const double* q_values = q_table.row(obs_to_key(observation));
     
     if (!deterministic && std::uniform_real_distribution<double>(0.0, 1.0)(rng) < epsilon) {
         // Explore: random action
         return std::uniform_int_distribution<int>(0, action_space_size - 1)(rng);
     } else {
         // Exploit: best action
-        const auto& q_values = q_table[obs_key];
-        return std::distance(q_values.begin(), 
-                           std::max_element(q_values.begin(), q_values.end()));
+        return greedy_action(q_values, action_space_size);
+    }
+}
+
+void QLearningAgent::predict_batch(const Observation* observations, int n, int* actions,
+                                   bool deterministic) {
+    std::uniform_real_distribution<double> explore_dist(0.0, 1.0);
+    std::uniform_int_distribution<int> action_dist(0, action_space_size - 1);
+    
+    for (int i = 0; i < n; i++) {
+        const double* q_values = q_table.row(obs_to_key(observations[i]));
+        if (!deterministic && explore_dist(rng) < epsilon) {
+            actions[i] = action_dist(rng);
+        } else {
+            actions[i] = greedy_action(q_values, action_space_size);
+        }
+    }
+}
+
+void QLearningAgent::greedy_actions(const Observation* observations, int n, int* actions) const {
+    for (int i = 0; i < n; i++) {
+        // An unvisited row is all zeros, where predict() also picks action 0
+        const double* q_values = q_table.find(obs_to_key(observations[i]));
+        actions[i] = q_values ? greedy_action(q_values, action_space_size) : 0;
     }
 }
 
 void QLearningAgent::learn(const Observation& obs, int action, double reward,
                           const Observation& next_obs, bool done) {
-    std::vector<int> obs_key = obs_to_key(obs);
-    std::vector<int> next_obs_key = obs_to_key(next_obs);
-    
-    ensure_q_entry(obs_key);
-    ensure_q_entry(next_obs_key);
+    double* q_values = q_table.row(obs_to_key(obs));
+    const double* next_q_values = q_table.row(obs_to_key(next_obs));
     
     // Q-learning update
-    double current_q = q_table[obs_key][action];
-    double next_max_q = done ? 0.0 : *std::max_element(q_table[next_obs_key].begin(),
-                                                       q_table[next_obs_key].end());
+    double next_max_q = done ? 0.0 : *std::max_element(next_q_values,
+                                                       next_q_values + action_space_size);
     double target_q = reward + gamma * next_max_q;
     
-    q_table[obs_key][action] += learning_rate * (target_q - current_q);
+    q_values[action] += learning_rate * (target_q - q_values[action]);
+}
+
+void QLearningAgent::learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                                 const Observation* next_obs, const uint8_t* dones, int n) {
+    // Sequential updates, so repeated states within the batch see each other
+    for (int i = 0; i < n; i++) {
+        QLearningAgent::learn(obs[i], actions[i], rewards[i], next_obs[i], dones[i] != 0);
+    }
 }
 
 void QLearningAgent::save_model(const std::string& filepath) {
@@ -124,14 +341,15 @@ void QLearningAgent::save_model(const std::string& filepath) {
         file << "q_table_size: " << q_table.size() << "\n";
         
         // Save Q-table
-        for (const auto& entry : q_table) {
+        for (unsigned long key : q_table.keys()) {
             file << "state: ";
-            for (int val : entry.first) {
+            for (int val : Observation(observation_space_size, key).to_vector()) {
                 file << val << " ";
             }
             file << "| values: ";
-            for (double val : entry.second) {
-                file << val << " ";
+            const double* q_values = q_table.find(key);
+            for (int a = 0; a < action_space_size; a++) {
+                file << q_values[a] << " ";
             }
             file << "\n";
         }
@@ -188,7 +406,15 @@ void QLearningAgent::load_model(const std::string& filepath) {
                 values.push_back(value);
             }
             
-            q_table[state] = values;
+            if ((int)state.size() != observation_space_size) {
+                throw std::runtime_error("State of " + std::to_string(state.size()) + 
+                                         " outcomes in " + filepath + " does not match memory size " +
+                                         std::to_string(observation_space_size));
+            }
+            double* q_values = q_table.row(Observation::from_vector(state).mu);
+            for (int a = 0; a < action_space_size && a < (int)values.size(); a++) {
+                q_values[a] = values[a];
+            }
         }
         
         file.close();
@@ -198,76 +424,187 @@ void QLearningAgent::load_model(const std::string& filepath) {
     }
 }
 
+std::map<std::string, double> QLearningAgent::get_hyperparameters() const {
+    return {{"learning_rate", learning_rate}, {"epsilon", epsilon}, {"gamma", gamma}};
+}
+
+void QLearningAgent::set_hyperparameters(const std::map<std::string, double>& params) {
+    if (params.count("learning_rate")) learning_rate = params.at("learning_rate");
+    if (params.count("gamma")) gamma = params.at("gamma");
+    if (params.count("epsilon")) restart_exploration(params.at("epsilon"));
+}
+
+// ReplayBuffer Implementation
+
+ReplayBuffer::ReplayBuffer(int capacity)
+    : capacity(std::max(1, capacity)), next_index(0), count(0),
+      states(this->capacity), next_states(this->capacity), rewards(this->capacity),
+      actions(this->capacity), done_bits((this->capacity + 63) / 64, 0) {}
+
+int ReplayBuffer::add(unsigned long state, int action, double reward,
+                      unsigned long next_state, bool done) {
+    int i = next_index;
+    states[i] = (uint32_t)state;
+    next_states[i] = (uint32_t)next_state;
+    rewards[i] = (float)reward;
+    actions[i] = (uint8_t)action;
+    uint64_t mask = 1ULL << (i & 63);
+    done_bits[i >> 6] = done ? (done_bits[i >> 6] | mask) : (done_bits[i >> 6] & ~mask);
+    
+    next_index = (next_index + 1) % capacity;
+    if (count < capacity) count++;
+    return i;
+}
+
+// SumTree Implementation
+
+SumTree::SumTree(int capacity) : leaf_count(1) {
+    while (leaf_count < capacity) leaf_count <<= 1;
+    nodes.assign(2 * leaf_count, 0.0);
+}
+
+void SumTree::update(int index, double priority) {
+    int node = leaf_count + index;
+    double delta = priority - nodes[node];
+    for (; node >= 1; node >>= 1) {
+        nodes[node] += delta;
+    }
+}
+
+int SumTree::find(double value) const {
+    int node = 1;
+    while (node < leaf_count) {
+        int left = 2 * node;
+        if (value < nodes[left] || nodes[left + 1] <= 0.0) {
+            node = left;
+        } else {
+            value -= nodes[left];
+            node = left + 1;
+        }
+    }
+    return node - leaf_count;
+}
+
+// Draw count replay slots from [0, buffer_size) into indices
+static void sample_replay_indices(std::mt19937& rng, int buffer_size, int count,
+                                  bool with_replacement, std::vector<int>& indices) {
+    indices.clear();
+    
+    if (with_replacement) {
+        std::uniform_int_distribution<int> index_dist(0, buffer_size - 1);
+        for (int i = 0; i < count; i++) {
+            indices.push_back(index_dist(rng));
+        }
+        return;
+    }
+    
+    // Floyd's algorithm: count distinct indices in O(count^2) time, independent
+    // of the buffer size (count is the small batch size)
+    for (int j = buffer_size - count; j < buffer_size; j++) {
+        int t = std::uniform_int_distribution<int>(0, j)(rng);
+        bool seen = std::find(indices.begin(), indices.end(), t) != indices.end();
+        indices.push_back(seen ? j : t);
+    }
+}
+
 // DQNAgent Implementation
 
 DQNAgent::DQNAgent(int obs_size, int action_size, double learning_rate,
                   double epsilon, double gamma, double epsilon_decay,
                   double epsilon_min, int memory_capacity, int batch_size,
-                  int target_update_frequency, unsigned int seed)
+                  int target_update_frequency, bool sample_with_replacement,
+                  unsigned int seed)
     : RLAgent(obs_size, action_size, seed), learning_rate(learning_rate),
       epsilon(epsilon), gamma(gamma), epsilon_decay(epsilon_decay),
       epsilon_min(epsilon_min), memory_capacity(memory_capacity),
       batch_size(batch_size), target_update_frequency(target_update_frequency),
-      update_counter(0), buffer_index(0), buffer_full(false) {
+      update_counter(0), sample_with_replacement(sample_with_replacement),
+      replay_buffer(memory_capacity), prioritized(false), priority_alpha(0.6),
+      priority_beta_start(0.4), priority_beta_steps(100000), priority_epsilon(1e-6),
+      max_priority(1.0), replay_steps(0),
+      main_network(obs_size, action_size), target_network(obs_size, action_size) {
     
-    replay_buffer.reserve(memory_capacity);
+    if (obs_size > 32) {
+        throw std::invalid_argument("DQNAgent supports observations of at most 32 bits");
+    }
+    batch_indices.reserve(batch_size);
+    exploration = ExplorationSchedule(epsilon, epsilon_decay, epsilon_min);
 }
 
-std::vector<int> DQNAgent::obs_to_key(const Observation& observation) const {
-    return observation.history;
+unsigned long DQNAgent::obs_to_key(const Observation& observation) const {
+    return observation.mu;
 }
 
-void DQNAgent::ensure_network_entry(const std::vector<int>& obs_key) {
-    if (main_network.find(obs_key) == main_network.end()) {
+double* DQNAgent::ensure_network_entry(unsigned long obs_key) {
+    bool created;
+    double* values = main_network.row(obs_key, &created);
+    if (created) {
         // Initialize with small random values
-        std::vector<double> values(action_space_size);
+        double* target_values = target_network.row(obs_key);
         std::uniform_real_distribution<double> init_dist(-0.1, 0.1);
-        for (double& val : values) {
-            val = init_dist(rng);
+        for (int a = 0; a < action_space_size; a++) {
+            values[a] = target_values[a] = init_dist(rng);
         }
-        main_network[obs_key] = values;
-        target_network[obs_key] = values;
     }
+    return values;
 }
 
-std::vector<double> DQNAgent::get_q_values(const std::vector<int>& obs_key, bool use_target) {
-    ensure_network_entry(obs_key);
-    return use_target ? target_network[obs_key] : main_network[obs_key];
+const double* DQNAgent::get_q_values(unsigned long obs_key, bool use_target) {
+    double* values = ensure_network_entry(obs_key);
+    return use_target ? target_network.row(obs_key) : values;
 }
 
 void DQNAgent::update_target_network() {
-    target_network = main_network;
+    target_network.copy_from(main_network);
 }
 
 int DQNAgent::predict(const Observation& observation, bool deterministic) {
-    std::vector<int> obs_key = obs_to_key(observation);
-    std::vector<double> q_values = get_q_values(obs_key);
+    unsigned long obs_key = obs_to_key(observation);
+    const double* q_values = get_q_values(obs_key);
     
     if (!deterministic && std::uniform_real_distribution<double>(0.0, 1.0)(rng) < epsilon) {
         // Explore: random action
         return std::uniform_int_distribution<int>(0, action_space_size - 1)(rng);
     } else {
         // Exploit: best action
-        return std::distance(q_values.begin(), 
-                           std::max_element(q_values.begin(), q_values.end()));
+        return greedy_action(q_values, action_space_size);
+    }
+}
+
+void DQNAgent::predict_batch(const Observation* observations, int n, int* actions,
+                             bool deterministic) {
+    std::uniform_real_distribution<double> explore_dist(0.0, 1.0);
+    std::uniform_int_distribution<int> action_dist(0, action_space_size - 1);
+    
+    for (int i = 0; i < n; i++) {
+        const double* q_values = get_q_values(obs_to_key(observations[i]));
+        if (!deterministic && explore_dist(rng) < epsilon) {
+            actions[i] = action_dist(rng);
+        } else {
+            actions[i] = greedy_action(q_values, action_space_size);
+        }
+    }
+}
+
+void DQNAgent::greedy_actions(const Observation* observations, int n, int* actions) const {
+    for (int i = 0; i < n; i++) {
+        // predict() would give an unvisited state random initial values
+        const double* q_values = main_network.find(obs_to_key(observations[i]));
+        actions[i] = q_values ? greedy_action(q_values, action_space_size) : 0;
     }
 }
 
 void DQNAgent::learn(const Observation& obs, int action, double reward,
                     const Observation& next_obs, bool done) {
     // Store experience in replay buffer
-    std::vector<int> obs_key = obs_to_key(obs);
-    std::vector<int> next_obs_key = obs_to_key(next_obs);
+    unsigned long obs_key = obs_to_key(obs);
+    unsigned long next_obs_key = obs_to_key(next_obs);
     
-    if ((int)replay_buffer.size() < memory_capacity) {
-        replay_buffer.emplace_back(obs_key, action, reward, next_obs_key, done);
-    } else {
-        replay_buffer[buffer_index] = Experience(obs_key, action, reward, next_obs_key, done);
-        buffer_full = true;
+    int slot = replay_buffer.add(obs_key, action, reward, next_obs_key, done);
+    if (prioritized) {
+        priorities.update(slot, max_priority);
     }
     
-    buffer_index = (buffer_index + 1) % memory_capacity;
-    
     // Perform experience replay if we have enough samples
     if ((int)get_replay_buffer_size() >= batch_size) {
         replay_experience();
@@ -280,39 +617,125 @@ void DQNAgent::learn(const Observation& obs, int action, double reward,
     }
 }
 
+void DQNAgent::learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                           const Observation* next_obs, const uint8_t* dones, int n) {
+    // Store the whole batch first, then run one replay step per transition
+    for (int i = 0; i < n; i++) {
+        int slot = replay_buffer.add(obs_to_key(obs[i]), actions[i], rewards[i],
+                                     obs_to_key(next_obs[i]), dones[i] != 0);
+        if (prioritized) {
+            priorities.update(slot, max_priority);
+        }
+    }
+    
+    for (int i = 0; i < n; i++) {
+        if ((int)get_replay_buffer_size() >= batch_size) {
+            replay_experience();
+        }
+        
+        update_counter++;
+        if (update_counter % target_update_frequency == 0) {
+            update_target_network();
+        }
+    }
+}
+
+void DQNAgent::enable_prioritized_replay(double alpha, double beta,
+                                         int beta_steps, double priority_eps) {
+    prioritized = true;
+    priority_alpha = alpha;
+    priority_beta_start = beta;
+    priority_beta_steps = std::max(1, beta_steps);
+    priority_epsilon = priority_eps;
+    max_priority = 1.0;
+    replay_steps = 0;
+    
+    // Transitions already stored start at the maximum priority
+    priorities = SumTree(replay_buffer.get_capacity());
+    for (int i = 0; i < replay_buffer.size(); i++) {
+        priorities.update(i, max_priority);
+    }
+    batch_weights.reserve(batch_size);
+}
+
+void DQNAgent::sample_prioritized_batch(int buffer_size, int count) {
+    batch_indices.clear();
+    batch_weights.clear();
+    
+    double beta = std::min(1.0, priority_beta_start +
+                           (1.0 - priority_beta_start) * replay_steps / priority_beta_steps);
+    replay_steps++;
+    
+    // Stratified sampling: one draw from each of count equal priority segments
+    double total = priorities.total();
+    double segment = total / count;
+    double max_weight = 0.0;
+    for (int i = 0; i < count; i++) {
+        double value = std::uniform_real_distribution<double>(i * segment, (i + 1) * segment)(rng);
+        int idx = std::min(priorities.find(std::min(value, std::nextafter(total, 0.0))), buffer_size - 1);
+        
+        // Importance-sampling weight (N * P(i))^-beta
+        double prob = priorities.get(idx) / total;
+        double weight = std::pow(buffer_size * prob, -beta);
+        max_weight = std::max(max_weight, weight);
+        
+        batch_indices.push_back(idx);
+        batch_weights.push_back(weight);
+    }
+    
+    // Normalize so the largest weight is 1
+    for (double& weight : batch_weights) {
+        weight /= max_weight;
+    }
+}
+
+void DQNAgent::sample_batch(int buffer_size, int count) {
+    if (prioritized) {
+        sample_prioritized_batch(buffer_size, count);
+        return;
+    }
+    
+    sample_replay_indices(rng, buffer_size, count, sample_with_replacement, batch_indices);
+}
+
 void DQNAgent::replay_experience() {
     int buffer_size = get_replay_buffer_size();
     
     // Sample random batch
-    std::vector<int> indices(buffer_size);
-    std::iota(indices.begin(), indices.end(), 0);
-    std::shuffle(indices.begin(), indices.end(), rng);
-    
     int actual_batch_size = std::min(batch_size, buffer_size);
+    sample_batch(buffer_size, actual_batch_size);
     
     for (int i = 0; i < actual_batch_size; i++) {
-        const Experience& exp = replay_buffer[indices[i]];
+        int idx = batch_indices[i];
+        int action = replay_buffer.action(idx);
+        double reward = replay_buffer.reward(idx);
         
-        // Get current Q-values
-        std::vector<double> current_q_values = get_q_values(exp.state);
+        // Get current Q-values (updated in place in the main network)
+        double* current_q_values = ensure_network_entry(replay_buffer.state(idx));
         
         // Calculate target Q-value
         double target_q;
-        if (exp.done) {
-            target_q = exp.reward;
+        if (replay_buffer.done(idx)) {
+            target_q = reward;
         } else {
-            std::vector<double> next_q_values = get_q_values(exp.next_state, true);
-            double max_next_q = *std::max_element(next_q_values.begin(), next_q_values.end());
-            target_q = exp.reward + gamma * max_next_q;
+            const double* next_q_values = get_q_values(replay_buffer.next_state(idx), true);
+            double max_next_q = *std::max_element(next_q_values, next_q_values + action_space_size);
+            target_q = reward + gamma * max_next_q;
         }
         
         // Update Q-value using gradient descent
-        double current_q = current_q_values[exp.action];
+        double current_q = current_q_values[action];
         double td_error = target_q - current_q;
-        current_q_values[exp.action] += learning_rate * td_error;
         
-        // Update main network
-        main_network[exp.state] = current_q_values;
+        if (prioritized) {
+            current_q_values[action] += learning_rate * batch_weights[i] * td_error;
+            
+            double priority = std::pow(std::abs(td_error) + priority_epsilon, priority_alpha);
+            priorities.update(idx, priority);
+            max_priority = std::max(max_priority, priority);
+        } else {
+            current_q_values[action] += learning_rate * td_error;
+        }
     }
 }
 
@@ -333,14 +756,15 @@ void DQNAgent::save_model(const std::string& filepath) {
         file << "network_size: " << main_network.size() << "\n";
         
         // Save main network
-        for (const auto& entry : main_network) {
+        for (unsigned long key : main_network.keys()) {
             file << "state: ";
-            for (int val : entry.first) {
+            for (int val : Observation(observation_space_size, key).to_vector()) {
                 file << val << " ";
             }
             file << "| values: ";
-            for (double val : entry.second) {
-                file << val << " ";
+            const double* q_values = main_network.find(key);
+            for (int a = 0; a < action_space_size; a++) {
+                file << q_values[a] << " ";
             }
             file << "\n";
         }
@@ -358,7 +782,7 @@ void DQNAgent::load_model(const std::string& filepath) {
         std::string line;
         
         // Read header information
-        for (int i = 0; i < 11; i++) {
+        for (int i = 0; i < 12; i++) {
             std::getline(file, line);
         }
         
@@ -392,8 +816,17 @@ void DQNAgent::load_model(const std::string& filepath) {
                 values.push_back(value);
             }
             
-            main_network[state] = values;
-            target_network[state] = values;
+            if ((int)state.size() != observation_space_size) {
+                throw std::runtime_error("State of " + std::to_string(state.size()) + 
+                                         " outcomes in " + filepath + " does not match memory size " +
+                                         std::to_string(observation_space_size));
+            }
+            unsigned long key = Observation::from_vector(state).mu;
+            double* main_values = main_network.row(key);
+            double* target_values = target_network.row(key);
+            for (int a = 0; a < action_space_size && a < (int)values.size(); a++) {
+                main_values[a] = target_values[a] = values[a];
+            }
         }
         
         file.close();
@@ -403,8 +836,275 @@ void DQNAgent::load_model(const std::string& filepath) {
     }
 }
 
+std::map<std::string, double> DQNAgent::get_hyperparameters() const {
+    return {{"learning_rate", learning_rate}, {"epsilon", epsilon}, {"gamma", gamma}};
+}
+
+void DQNAgent::set_hyperparameters(const std::map<std::string, double>& params) {
+    if (params.count("learning_rate")) learning_rate = params.at("learning_rate");
+    if (params.count("gamma")) gamma = params.at("gamma");
+    if (params.count("epsilon")) restart_exploration(params.at("epsilon"));
+}
+
+// NeuralDQNAgent Implementation
+
+// Layer sizes of a network mapping obs_size inputs to action_size outputs
+static std::vector<int> mlp_layer_sizes(int obs_size, const std::vector<int>& hidden_sizes,
+                                        int action_size) {
+    std::vector<int> sizes;
+    sizes.push_back(obs_size);
+    sizes.insert(sizes.end(), hidden_sizes.begin(), hidden_sizes.end());
+    sizes.push_back(action_size);
+    return sizes;
+}
+
+NeuralDQNAgent::NeuralDQNAgent(int obs_size, int action_size,
+                               const std::vector<int>& hidden_sizes,
+                               double learning_rate, double epsilon, double gamma,
+                               double epsilon_decay, double epsilon_min,
+                               int memory_capacity, int batch_size,
+                               int target_update_frequency, bool sample_with_replacement,
+                               unsigned int seed)
+    : RLAgent(obs_size, action_size, seed), learning_rate(learning_rate),
+      epsilon(epsilon), gamma(gamma), epsilon_decay(epsilon_decay),
+      epsilon_min(epsilon_min), memory_capacity(memory_capacity),
+      batch_size(batch_size), target_update_frequency(target_update_frequency),
+      update_counter(0), sample_with_replacement(sample_with_replacement),
+      replay_buffer(memory_capacity),
+      main_network(mlp_layer_sizes(obs_size, hidden_sizes, action_size), seed),
+      target_network(mlp_layer_sizes(obs_size, hidden_sizes, action_size), seed) {
+    
+    if (obs_size > 32) {
+        throw std::invalid_argument("NeuralDQNAgent supports observations of at most 32 bits");
+    }
+    batch_indices.reserve(batch_size);
+    exploration = ExplorationSchedule(epsilon, epsilon_decay, epsilon_min);
+    input_batch.resize((size_t)batch_size * obs_size);
+    next_input_batch.resize((size_t)batch_size * obs_size);
+    target_values.resize(batch_size);
+    grad_output.resize((size_t)batch_size * action_size);
+}
+
+unsigned long NeuralDQNAgent::obs_to_key(const Observation& observation) const {
+    return observation.mu;
+}
+
+void NeuralDQNAgent::encode_state(unsigned long obs_key, float* input) const {
+    for (int i = 0; i < observation_space_size; i++) {
+        input[i] = ((obs_key >> i) & 1UL) ? 1.0f : -1.0f;
+    }
+}
+
+int NeuralDQNAgent::predict(const Observation& observation, bool deterministic) {
+    if (!deterministic && std::uniform_real_distribution<double>(0.0, 1.0)(rng) < epsilon) {
+        // Explore: random action
+        return std::uniform_int_distribution<int>(0, action_space_size - 1)(rng);
+    }
+    
+    // Exploit: best action
+    encode_state(obs_to_key(observation), input_batch.data());
+    const float* q_values = main_network.forward(input_batch.data(), 1);
+    return greedy_action(q_values, action_space_size);
+}
+
+void NeuralDQNAgent::predict_batch(const Observation* observations, int n, int* actions,
+                                   bool deterministic) {
+    std::uniform_real_distribution<double> explore_dist(0.0, 1.0);
+    std::uniform_int_distribution<int> action_dist(0, action_space_size - 1);
+    
+    // Draw exploration first, then evaluate all exploiting items in one forward pass
+    greedy_rows.clear();
+    for (int i = 0; i < n; i++) {
+        if (!deterministic && explore_dist(rng) < epsilon) {
+            actions[i] = action_dist(rng);
+        } else {
+            greedy_rows.push_back(i);
+        }
+    }
+    if (greedy_rows.empty()) return;
+    
+    int rows = greedy_rows.size();
+    predict_input.resize((size_t)rows * observation_space_size);
+    for (int r = 0; r < rows; r++) {
+        encode_state(obs_to_key(observations[greedy_rows[r]]),
+                     &predict_input[(size_t)r * observation_space_size]);
+    }
+    
+    const float* q_values = main_network.forward(predict_input.data(), rows);
+    for (int r = 0; r < rows; r++) {
+        actions[greedy_rows[r]] = greedy_action(q_values + (size_t)r * action_space_size,
+                                                action_space_size);
+    }
+}
+
+void NeuralDQNAgent::greedy_actions(const Observation* observations, int n, int* actions) const {
+    std::vector<float> input((size_t)n * observation_space_size);
+    for (int i = 0; i < n; i++) {
+        encode_state(obs_to_key(observations[i]), &input[(size_t)i * observation_space_size]);
+    }
+    
+    std::vector<std::vector<float>> layers;
+    const float* q_values = main_network.infer(input.data(), n, layers);
+    for (int i = 0; i < n; i++) {
+        actions[i] = greedy_action(q_values + (size_t)i * action_space_size, action_space_size);
+    }
+}
+
+void NeuralDQNAgent::learn(const Observation& obs, int action, double reward,
+                          const Observation& next_obs, bool done) {
+    replay_buffer.add(obs_to_key(obs), action, reward, obs_to_key(next_obs), done);
+    
+    // Perform experience replay if we have enough samples
+    if ((int)get_replay_buffer_size() >= batch_size) {
+        replay_experience();
+    }
+    
+    // Update target network periodically
+    update_counter++;
+    if (update_counter % target_update_frequency == 0) {
+        target_network.copy_parameters_from(main_network);
+    }
+}
+
+void NeuralDQNAgent::learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                                 const Observation* next_obs, const uint8_t* dones, int n) {
+    // Store the whole batch first, then run one replay step per transition
+    for (int i = 0; i < n; i++) {
+        replay_buffer.add(obs_to_key(obs[i]), actions[i], rewards[i],
+                          obs_to_key(next_obs[i]), dones[i] != 0);
+    }
+    
+    for (int i = 0; i < n; i++) {
+        if ((int)get_replay_buffer_size() >= batch_size) {
+            replay_experience();
+        }
+        
+        update_counter++;
+        if (update_counter % target_update_frequency == 0) {
+            target_network.copy_parameters_from(main_network);
+        }
+    }
+}
+
+void NeuralDQNAgent::replay_experience() {
+    int count = std::min(batch_size, (int)get_replay_buffer_size());
+    sample_replay_indices(rng, replay_buffer.size(), count, sample_with_replacement, batch_indices);
+    
+    for (int i = 0; i < count; i++) {
+        int idx = batch_indices[i];
+        encode_state(replay_buffer.state(idx), &input_batch[(size_t)i * observation_space_size]);
+        encode_state(replay_buffer.next_state(idx), &next_input_batch[(size_t)i * observation_space_size]);
+    }
+    
+    // Bootstrapped targets from the target network
+    const float* next_q = target_network.forward(next_input_batch.data(), count);
+    for (int i = 0; i < count; i++) {
+        int idx = batch_indices[i];
+        double target_q = replay_buffer.reward(idx);
+        if (!replay_buffer.done(idx)) {
+            const float* row = next_q + (size_t)i * action_space_size;
+            target_q += gamma * *std::max_element(row, row + action_space_size);
+        }
+        target_values[i] = target_q;
+    }
+    
+    // Huber loss gradient on the taken action only, averaged over the batch
+    const float* q = main_network.forward(input_batch.data(), count);
+    std::fill(grad_output.begin(), grad_output.begin() + (size_t)count * action_space_size, 0.0f);
+    for (int i = 0; i < count; i++) {
+        size_t pos = (size_t)i * action_space_size + replay_buffer.action(batch_indices[i]);
+        float td_error = q[pos] - target_values[i];
+        grad_output[pos] = std::max(-1.0f, std::min(1.0f, td_error)) / count;
+    }
+    
+    main_network.backward(grad_output.data());
+    main_network.adam_step(learning_rate);
+}
+
+void NeuralDQNAgent::save_model(const std::string& filepath) {
+    std::ofstream file(filepath);
+    if (file.is_open()) {
+        file << "NeuralDQNAgent\n";
+        file << "observation_space_size: " << observation_space_size << "\n";
+        file << "action_space_size: " << action_space_size << "\n";
+        file << "learning_rate: " << learning_rate << "\n";
+        file << "epsilon: " << epsilon << "\n";
+        file << "gamma: " << gamma << "\n";
+        file << "epsilon_decay: " << epsilon_decay << "\n";
+        file << "epsilon_min: " << epsilon_min << "\n";
+        file << "memory_capacity: " << memory_capacity << "\n";
+        file << "batch_size: " << batch_size << "\n";
+        file << "target_update_frequency: " << target_update_frequency << "\n";
+        
+        // Save main network
+        main_network.save_to_stream(file);
+        
+        file.close();
+        std::cout << "Neural DQN agent model saved to " << filepath << std::endl;
+    } else {
+        throw std::runtime_error("Could not open file for writing: " + filepath);
+    }
+}
+
+void NeuralDQNAgent::load_model(const std::string& filepath) {
+    std::ifstream file(filepath);
+    if (file.is_open()) {
+        std::string line;
+        
+        // Read header information
+        for (int i = 0; i < 11; i++) {
+            std::getline(file, line);
+        }
+        
+        main_network.load_from_stream(file);
+        target_network.copy_parameters_from(main_network);
+        
+        file.close();
+        std::cout << "Neural DQN agent model loaded from " << filepath << std::endl;
+    } else {
+        throw std::runtime_error("Could not open file for reading: " + filepath);
+    }
+}
+
+std::map<std::string, double> NeuralDQNAgent::get_hyperparameters() const {
+    return {{"learning_rate", learning_rate}, {"epsilon", epsilon}, {"gamma", gamma}};
+}
+
+void NeuralDQNAgent::set_hyperparameters(const std::map<std::string, double>& params) {
+    if (params.count("learning_rate")) learning_rate = params.at("learning_rate");
+    if (params.count("gamma")) gamma = params.at("gamma");
+    if (params.count("epsilon")) restart_exploration(params.at("epsilon"));
+}
+
 // Factory function implementation
 
+// Exploration schedule from the agent parameters: epsilon_schedule selects
+// the shape (0 exponential, 1 linear, 2 step), epsilon_per_step ticks it
+// every environment step instead of every episode, and epsilon_decay_ticks
+// and epsilon_step_interval set the linear horizon and the step interval
+static ExplorationSchedule schedule_from_params(const std::map<std::string, double>& params,
+                                                double epsilon, double epsilon_decay,
+                                                double epsilon_min) {
+    ExplorationSchedule schedule(epsilon, epsilon_decay, epsilon_min);
+    if (params.count("epsilon_schedule")) {
+        int type = (int)params.at("epsilon_schedule");
+        if (type < 0 || type > (int)ScheduleType::STEP) {
+            throw std::invalid_argument("Unknown epsilon_schedule: " + std::to_string(type));
+        }
+        schedule.type = (ScheduleType)type;
+    }
+    if (params.count("epsilon_per_step") && params.at("epsilon_per_step") != 0.0) {
+        schedule.unit = ScheduleUnit::STEP;
+    }
+    if (params.count("epsilon_decay_ticks")) {
+        schedule.decay_ticks = (long)params.at("epsilon_decay_ticks");
+    }
+    if (params.count("epsilon_step_interval")) {
+        schedule.interval = (long)params.at("epsilon_step_interval");
+    }
+    return schedule;
+}
+
 std::unique_ptr<RLAgent> create_agent(const std::string& agent_type, 
                                      int obs_size, int action_size,
                                      const std::map<std::string, double>& params,
@@ -418,8 +1118,10 @@ std::unique_ptr<RLAgent> create_agent(const std::string& agent_type,
         double eps_decay = params.count("epsilon_decay") ? params.at("epsilon_decay") : 0.995;
         double eps_min = params.count("epsilon_min") ? params.at("epsilon_min") : 0.01;
         
-        return std::make_unique<QLearningAgent>(obs_size, action_size, lr, eps, 
-                                               gamma, eps_decay, eps_min, seed);
+        auto agent = std::make_unique<QLearningAgent>(obs_size, action_size, lr, eps, 
+                                                     gamma, eps_decay, eps_min, seed);
+        agent->set_exploration_schedule(schedule_from_params(params, eps, eps_decay, eps_min));
+        return agent;
     } else if (agent_type == "dqn") {
         double lr = params.count("learning_rate") ? params.at("learning_rate") : 0.001;
         double eps = params.count("epsilon") ? params.at("epsilon") : 1.0;
@@ -429,10 +1131,41 @@ std::unique_ptr<RLAgent> create_agent(const std::string& agent_type,
         int memory = params.count("memory_capacity") ? (int)params.at("memory_capacity") : 10000;
         int batch = params.count("batch_size") ? (int)params.at("batch_size") : 32;
         int target_freq = params.count("target_update_frequency") ? (int)params.at("target_update_frequency") : 100;
+        bool with_replacement = params.count("sample_with_replacement") ? params.at("sample_with_replacement") != 0.0 : false;
+        
+        auto agent = std::make_unique<DQNAgent>(obs_size, action_size, lr, eps, gamma,
+                                               eps_decay, eps_min, memory, batch, 
+                                               target_freq, with_replacement, seed);
+        agent->set_exploration_schedule(schedule_from_params(params, eps, eps_decay, eps_min));
+        
+        if (params.count("prioritized_replay") && params.at("prioritized_replay") != 0.0) {
+            double alpha = params.count("priority_alpha") ? params.at("priority_alpha") : 0.6;
+            double beta = params.count("priority_beta") ? params.at("priority_beta") : 0.4;
+            int beta_steps = params.count("priority_beta_steps") ? (int)params.at("priority_beta_steps") : 100000;
+            double priority_eps = params.count("priority_epsilon") ? params.at("priority_epsilon") : 1e-6;
+            agent->enable_prioritized_replay(alpha, beta, beta_steps, priority_eps);
+        }
+        
+        return agent;
+    } else if (agent_type == "neural_dqn") {
+        double lr = params.count("learning_rate") ? params.at("learning_rate") : 0.001;
+        double eps = params.count("epsilon") ? params.at("epsilon") : 1.0;
+        double gamma = params.count("gamma") ? params.at("gamma") : 0.95;
+        double eps_decay = params.count("epsilon_decay") ? params.at("epsilon_decay") : 0.995;
+        double eps_min = params.count("epsilon_min") ? params.at("epsilon_min") : 0.01;
+        int memory = params.count("memory_capacity") ? (int)params.at("memory_capacity") : 10000;
+        int batch = params.count("batch_size") ? (int)params.at("batch_size") : 32;
+        int target_freq = params.count("target_update_frequency") ? (int)params.at("target_update_frequency") : 100;
+        bool with_replacement = params.count("sample_with_replacement") ? params.at("sample_with_replacement") != 0.0 : false;
+        int hidden_size = params.count("hidden_size") ? (int)params.at("hidden_size") : 64;
+        int hidden_layers = params.count("hidden_layers") ? (int)params.at("hidden_layers") : 2;
         
-        return std::make_unique<DQNAgent>(obs_size, action_size, lr, eps, gamma,
-                                         eps_decay, eps_min, memory, batch, 
-                                         target_freq, seed);
+        std::vector<int> hidden_sizes(std::max(0, hidden_layers), hidden_size);
+        auto agent = std::make_unique<NeuralDQNAgent>(obs_size, action_size, hidden_sizes, lr, eps,
+                                                     gamma, eps_decay, eps_min, memory, batch,
+                                                     target_freq, with_replacement, seed);
+        agent->set_exploration_schedule(schedule_from_params(params, eps, eps_decay, eps_min));
+        return agent;
     } else {
         throw std::invalid_argument("Unknown agent type: " + agent_type);
     }
@@ -14,7 +14,174 @@
 #include <random>
 #include <string>
 #include <fstream>
+#include <unordered_map>
+#include <new>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <cassert>
 #include "minority_game_env.h"
+#include "neural_network.h"
+
+// Allocator returning cache-line aligned storage
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    typedef T value_type;
+    
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+    
+    template <typename U>
+    struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+    
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+    
+    bool operator==(const AlignedAllocator&) const { return true; }
+    bool operator!=(const AlignedAllocator&) const { return false; }
+};
+
+// Tabular action values keyed by packed observation. Observation spaces of
+// up to DENSE_MAX_BITS bits use a dense, cache-aligned [2^M][A] array;
+// larger ones fall back to a sparse hash map.
+class QTable {
+private:
+    int num_actions;
+    bool dense;
+    std::vector<double, AlignedAllocator<double>> values;  // Dense rows
+    std::vector<char> visited;                             // Dense visit flags
+    size_t num_visited;
+    std::unordered_map<unsigned long, std::vector<double>> sparse;
+    
+public:
+    static const int DENSE_MAX_BITS = 16;
+    
+    QTable(int obs_bits = 0, int num_actions = 2);
+    
+    // Action values of a state, creating a zero entry on first visit.
+    // If created is given it is set to whether the entry is new.
+    double* row(unsigned long key, bool* created = nullptr) {
+        if (dense) {
+            assert(key < visited.size());
+            if (!visited[key]) {
+                visited[key] = 1;
+                num_visited++;
+                if (created) *created = true;
+            } else if (created) {
+                *created = false;
+            }
+            return &values[key * num_actions];
+        }
+        auto it = sparse.find(key);
+        if (created) *created = (it == sparse.end());
+        if (it == sparse.end()) {
+            it = sparse.emplace(key, std::vector<double>(num_actions, 0.0)).first;
+        }
+        return it->second.data();
+    }
+    
+    // Action values of a visited state, or nullptr
+    const double* find(unsigned long key) const;
+    
+    bool is_dense() const { return dense; }
+    int get_num_actions() const { return num_actions; }
+    size_t size() const { return dense ? num_visited : sparse.size(); }
+    void clear();
+    
+    // Visited states in increasing key order
+    std::vector<unsigned long> keys() const;
+    
+    // Make this table an exact copy of other. Dense tables of equal shape
+    // are copied with a single memcpy and no allocation.
+    void copy_from(const QTable& other);
+};
+
+// How concurrent learners write to a SharedQTable
+enum class SharedUpdateMode {
+    HOGWILD,        // Lock-free relaxed atomic updates; racing updates may be lost
+    STRIPED_LOCKS   // Updates of a state serialized by one of a fixed pool of mutexes
+};
+
+// Dense [2^M][A] action-value table shared by several learner threads.
+// Values are relaxed atomics, so readers never block and never see torn
+// values; writers either race (Hogwild) or take a per-state striped lock.
+class SharedQTable {
+private:
+    static const int NUM_STRIPES = 256;
+    
+    // Mutex padded to a cache line so neighbouring stripes do not false-share
+    struct alignas(64) Stripe {
+        std::mutex lock;
+    };
+    
+    int num_actions;
+    size_t num_states;
+    SharedUpdateMode mode;
+    std::unique_ptr<std::atomic<double>[]> values;
+    std::unique_ptr<std::atomic<uint8_t>[]> visited;
+    std::unique_ptr<Stripe[]> stripes;
+    
+    void mark_visited(unsigned long key) {
+        if (!visited[key].load(std::memory_order_relaxed)) {
+            visited[key].store(1, std::memory_order_relaxed);
+        }
+    }
+    
+public:
+    SharedQTable(int obs_bits, int num_actions, SharedUpdateMode mode = SharedUpdateMode::HOGWILD);
+    
+    // Best action and largest value of a state (first action on ties)
+    int greedy_action(unsigned long key);
+    double max_value(unsigned long key);
+    
+    // Q(key, action) += learning_rate * (target - Q(key, action))
+    void update(unsigned long key, int action, double learning_rate, double target);
+    
+    // Transfer visited states to and from a single-threaded table
+    void copy_from(const QTable& table);
+    void copy_to(QTable& table) const;
+    
+    SharedUpdateMode get_mode() const { return mode; }
+};
+
+// Shape of an exploration schedule
+enum class ScheduleType {
+    EXPONENTIAL,    // Multiply by decay every tick
+    LINEAR,         // Straight line from start to minimum over decay_ticks
+    STEP            // Multiply by decay every interval ticks
+};
+
+// What one tick of an exploration schedule is
+enum class ScheduleUnit {
+    EPISODE,
+    STEP            // One environment step, for decay within long episodes
+};
+
+// Exploration rate as a function of the ticks trained so far, never below
+// minimum. The default is the per-episode exponential decay.
+struct ExplorationSchedule {
+    ScheduleType type;
+    ScheduleUnit unit;
+    double start;
+    double minimum;
+    double decay;       // EXPONENTIAL and STEP factor
+    long decay_ticks;   // LINEAR horizon
+    long interval;      // STEP interval
+    
+    ExplorationSchedule(double start = 0.0, double decay = 1.0, double minimum = 0.0,
+                        ScheduleType type = ScheduleType::EXPONENTIAL,
+                        ScheduleUnit unit = ScheduleUnit::EPISODE,
+                        long decay_ticks = 1000, long interval = 100)
+        : type(type), unit(unit), start(start), minimum(minimum), decay(decay),
+          decay_ticks(decay_ticks), interval(interval) {}
+    
+    double value(long ticks) const;
+};
 
 // Base class for RL agents
 class RLAgent {
@@ -23,6 +190,12 @@ protected:
     int action_space_size;
     std::mt19937 rng;
     
+    ExplorationSchedule exploration;
+    long exploration_ticks;
+    
+    // Receives the scheduled exploration rate; agents that explore override it
+    virtual void apply_exploration_rate(double) {}
+    
 public:
     RLAgent(int obs_size, int action_size, unsigned int seed = 0);
     virtual ~RLAgent() = default;
@@ -32,10 +205,56 @@ public:
     virtual void learn(const Observation& obs, int action, double reward, 
                       const Observation& next_obs, bool done) = 0;
     
+    // Batched versions of predict and learn over n observations/transitions.
+    // The defaults loop over the single-item calls; agents override them to
+    // avoid per-item dispatch and to share work across the batch.
+    virtual void predict_batch(const Observation* observations, int n, int* actions,
+                               bool deterministic = false);
+    virtual void learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                             const Observation* next_obs, const uint8_t* dones, int n);
+    
+    // Greedy actions for n observations without changing the agent: no
+    // values are created for unvisited states and the RNG is not drawn
+    // from. Table agents pick action 0 in states they have not visited.
+    // Throws std::logic_error for agents without a deterministic policy.
+    virtual void greedy_actions(const Observation* observations, int n, int* actions) const;
+    
     // Model persistence
     virtual void save_model(const std::string& filepath) = 0;
     virtual void load_model(const std::string& filepath) = 0;
     
+    // In-memory copy of the agent: learned values, replay memory,
+    // hyperparameters, exploration state and RNG
+    virtual std::unique_ptr<RLAgent> clone() const = 0;
+    
+    // Hyperparameters that population-based training may change
+    // (learning_rate, epsilon, gamma); unknown names are ignored. A new
+    // epsilon restarts the exploration schedule from that value.
+    virtual std::map<std::string, double> get_hyperparameters() const { return {}; }
+    virtual void set_hyperparameters(const std::map<std::string, double>& /* params */) {}
+    
+    void reseed(unsigned int seed) { rng.seed(seed); }
+    
+    // True when predict(observation, true) depends on the observation only,
+    // so the policy can be tabulated and shared across threads
+    virtual bool has_deterministic_policy() const { return true; }
+    
+    // Replace the exploration schedule and restart it
+    void set_exploration_schedule(const ExplorationSchedule& schedule);
+    // Restart the current schedule from a new initial rate
+    void restart_exploration(double start);
+    
+    // Trainers call this after every environment step and every episode;
+    // only ticks of the schedule's unit advance it
+    void advance_exploration(ScheduleUnit unit, long ticks = 1) {
+        if (unit != exploration.unit) return;
+        exploration_ticks += ticks;
+        apply_exploration_rate(exploration.value(exploration_ticks));
+    }
+    
+    const ExplorationSchedule& get_exploration_schedule() const { return exploration; }
+    long get_exploration_ticks() const { return exploration_ticks; }
+    
     // Getters
     int get_observation_space_size() const { return observation_space_size; }
     int get_action_space_size() const { return action_space_size; }
@@ -55,6 +274,12 @@ public:
     
     void save_model(const std::string& filepath) override;
     void load_model(const std::string& filepath) override;
+    
+    std::unique_ptr<RLAgent> clone() const override {
+        return std::make_unique<RandomAgent>(*this);
+    }
+    
+    bool has_deterministic_policy() const override { return false; }
 };
 
 // Simple Q-Learning agent
@@ -66,12 +291,13 @@ private:
     double epsilon_decay;
     double epsilon_min;
     
-    // Q-table: maps observation to action values
-    std::map<std::vector<int>, std::vector<double>> q_table;
+    // Q-table: maps packed observation to action values
+    QTable q_table;
     
     // Helper methods
-    std::vector<int> obs_to_key(const Observation& observation) const;
-    void ensure_q_entry(const std::vector<int>& obs_key);
+    unsigned long obs_to_key(const Observation& observation) const;
+    
+    void apply_exploration_rate(double rate) override { epsilon = rate; }
     
 public:
     QLearningAgent(int obs_size, int action_size, 
@@ -82,19 +308,85 @@ public:
     int predict(const Observation& observation, bool deterministic = false) override;
     void learn(const Observation& obs, int action, double reward, 
               const Observation& next_obs, bool done) override;
+    void predict_batch(const Observation* observations, int n, int* actions,
+                       bool deterministic = false) override;
+    void greedy_actions(const Observation* observations, int n, int* actions) const override;
+    void learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                     const Observation* next_obs, const uint8_t* dones, int n) override;
     
     void save_model(const std::string& filepath) override;
     void load_model(const std::string& filepath) override;
     
+    std::unique_ptr<RLAgent> clone() const override {
+        return std::make_unique<QLearningAgent>(*this);
+    }
+    std::map<std::string, double> get_hyperparameters() const override;
+    void set_hyperparameters(const std::map<std::string, double>& params) override;
+    
     // Getters for hyperparameters
     double get_learning_rate() const { return learning_rate; }
     double get_epsilon() const { return epsilon; }
     double get_gamma() const { return gamma; }
+    double get_epsilon_decay() const { return epsilon_decay; }
+    double get_epsilon_min() const { return epsilon_min; }
     size_t get_q_table_size() const { return q_table.size(); }
+    const QTable& get_q_table() const { return q_table; }
+    QTable& get_q_table() { return q_table; }
     
     // Setters for hyperparameters
     void set_epsilon(double new_epsilon) { epsilon = std::max(epsilon_min, new_epsilon); }
-    void decay_epsilon() { epsilon = std::max(epsilon_min, epsilon * epsilon_decay); }
+};
+
+// Fixed-capacity replay buffer stored as parallel arrays, preallocated at
+// construction. Packed states are 32-bit, so a transition takes about
+// 13 bytes (two states, float reward, uint8 action and one done bit).
+class ReplayBuffer {
+private:
+    int capacity;
+    int next_index;  // Slot overwritten by the next add()
+    int count;       // Number of stored transitions
+    
+    std::vector<uint32_t> states;
+    std::vector<uint32_t> next_states;
+    std::vector<float> rewards;
+    std::vector<uint8_t> actions;
+    std::vector<uint64_t> done_bits;
+    
+public:
+    ReplayBuffer(int capacity);
+    
+    // Store a transition, overwriting the oldest one when full.
+    // Returns the slot it was written to.
+    int add(unsigned long state, int action, double reward,
+            unsigned long next_state, bool done);
+    
+    int size() const { return count; }
+    int get_capacity() const { return capacity; }
+    
+    unsigned long state(int i) const { return states[i]; }
+    unsigned long next_state(int i) const { return next_states[i]; }
+    double reward(int i) const { return rewards[i]; }
+    int action(int i) const { return actions[i]; }
+    bool done(int i) const { return (done_bits[i >> 6] >> (i & 63)) & 1ULL; }
+};
+
+// Flat-array sum tree over replay slots for prioritized sampling. Leaves
+// hold slot priorities and each internal node the sum of its children, so
+// updates and prefix-sum searches are O(log n).
+class SumTree {
+private:
+    int leaf_count;              // Power of two >= capacity
+    std::vector<double> nodes;   // nodes[1] is the root, leaves start at leaf_count
+    
+public:
+    SumTree(int capacity = 0);
+    
+    void update(int index, double priority);
+    double get(int index) const { return nodes[leaf_count + index]; }
+    double total() const { return nodes[1]; }
+    
+    // Slot whose cumulative priority range contains value, 0 <= value < total()
+    int find(double value) const;
 };
 
 // Deep Q-Network agent (simplified version using tabular approximation)
@@ -109,60 +401,154 @@ private:
     int batch_size;
     int target_update_frequency;
     int update_counter;
+    bool sample_with_replacement;
+    std::vector<int> batch_indices;  // Reused sample buffer
     
     // Experience replay buffer
-    struct Experience {
-        std::vector<int> state;
-        int action;
-        double reward;
-        std::vector<int> next_state;
-        bool done;
-        
-        Experience(const std::vector<int>& s, int a, double r, 
-                  const std::vector<int>& ns, bool d)
-            : state(s), action(a), reward(r), next_state(ns), done(d) {}
-    };
+    ReplayBuffer replay_buffer;
     
-    std::vector<Experience> replay_buffer;
-    int buffer_index;
-    bool buffer_full;
+    // Prioritized replay (disabled unless enable_prioritized_replay is called)
+    bool prioritized;
+    double priority_alpha;       // Priority exponent
+    double priority_beta_start;  // Initial importance-sampling exponent
+    int priority_beta_steps;     // Replay calls over which beta anneals to 1
+    double priority_epsilon;     // Keeps every priority positive
+    double max_priority;         // Priority given to new transitions
+    long replay_steps;
+    SumTree priorities;
+    std::vector<double> batch_weights;  // Importance-sampling weights of the batch
     
     // Neural network approximation using lookup table
-    std::map<std::vector<int>, std::vector<double>> main_network;
-    std::map<std::vector<int>, std::vector<double>> target_network;
+    QTable main_network;
+    QTable target_network;
     
     // Helper methods
-    std::vector<int> obs_to_key(const Observation& observation) const;
-    void ensure_network_entry(const std::vector<int>& obs_key);
-    std::vector<double> get_q_values(const std::vector<int>& obs_key, bool use_target = false);
+    unsigned long obs_to_key(const Observation& observation) const;
+    double* ensure_network_entry(unsigned long obs_key);
+    const double* get_q_values(unsigned long obs_key, bool use_target = false);
     void update_target_network();
+    void sample_batch(int buffer_size, int count);
+    void sample_prioritized_batch(int buffer_size, int count);
     void replay_experience();
     
+    void apply_exploration_rate(double rate) override { epsilon = rate; }
+    
 public:
     DQNAgent(int obs_size, int action_size,
             double learning_rate = 0.001, double epsilon = 1.0,
             double gamma = 0.95, double epsilon_decay = 0.995,
             double epsilon_min = 0.01, int memory_capacity = 10000,
             int batch_size = 32, int target_update_frequency = 100,
-            unsigned int seed = 0);
+            bool sample_with_replacement = false, unsigned int seed = 0);
     
     int predict(const Observation& observation, bool deterministic = false) override;
     void learn(const Observation& obs, int action, double reward, 
               const Observation& next_obs, bool done) override;
+    void predict_batch(const Observation* observations, int n, int* actions,
+                       bool deterministic = false) override;
+    void greedy_actions(const Observation* observations, int n, int* actions) const override;
+    void learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                     const Observation* next_obs, const uint8_t* dones, int n) override;
     
     void save_model(const std::string& filepath) override;
     void load_model(const std::string& filepath) override;
     
+    std::unique_ptr<RLAgent> clone() const override {
+        return std::make_unique<DQNAgent>(*this);
+    }
+    std::map<std::string, double> get_hyperparameters() const override;
+    void set_hyperparameters(const std::map<std::string, double>& params) override;
+    
+    // Switch to prioritized experience replay
+    void enable_prioritized_replay(double alpha = 0.6, double beta = 0.4,
+                                   int beta_steps = 100000, double priority_eps = 1e-6);
+    
     // Getters
     double get_learning_rate() const { return learning_rate; }
     double get_epsilon() const { return epsilon; }
     double get_gamma() const { return gamma; }
-    size_t get_replay_buffer_size() const { return buffer_full ? memory_capacity : buffer_index; }
+    bool is_prioritized() const { return prioritized; }
+    size_t get_replay_buffer_size() const { return replay_buffer.size(); }
     size_t get_network_size() const { return main_network.size(); }
     
     // Setters
     void set_epsilon(double new_epsilon) { epsilon = std::max(epsilon_min, new_epsilon); }
-    void decay_epsilon() { epsilon = std::max(epsilon_min, epsilon * epsilon_decay); }
+};
+
+// Deep Q-Network agent with a multi-layer perceptron Q-function. Each memory
+// bit is fed to the network as a +/-1 input, so action values generalize
+// across histories instead of being stored per state.
+class NeuralDQNAgent : public RLAgent {
+private:
+    double learning_rate;
+    double epsilon;
+    double gamma;
+    double epsilon_decay;
+    double epsilon_min;
+    int memory_capacity;
+    int batch_size;
+    int target_update_frequency;
+    int update_counter;
+    bool sample_with_replacement;
+    std::vector<int> batch_indices;  // Reused sample buffer
+    
+    // Experience replay buffer
+    ReplayBuffer replay_buffer;
+    
+    MLP main_network;
+    MLP target_network;
+    
+    // Reused minibatch buffers
+    std::vector<float> input_batch;       // [batch x obs_size]
+    std::vector<float> next_input_batch;  // [batch x obs_size]
+    std::vector<float> target_values;     // [batch]
+    std::vector<float> grad_output;       // [batch x action_size]
+    std::vector<float> predict_input;     // [n x obs_size] for predict_batch
+    std::vector<int> greedy_rows;         // predict_batch items that exploit
+    
+    // Helper methods
+    unsigned long obs_to_key(const Observation& observation) const;
+    void encode_state(unsigned long obs_key, float* input) const;
+    void replay_experience();
+    
+    void apply_exploration_rate(double rate) override { epsilon = rate; }
+    
+public:
+    NeuralDQNAgent(int obs_size, int action_size,
+                  const std::vector<int>& hidden_sizes = {64, 64},
+                  double learning_rate = 0.001, double epsilon = 1.0,
+                  double gamma = 0.95, double epsilon_decay = 0.995,
+                  double epsilon_min = 0.01, int memory_capacity = 10000,
+                  int batch_size = 32, int target_update_frequency = 100,
+                  bool sample_with_replacement = false, unsigned int seed = 0);
+    
+    int predict(const Observation& observation, bool deterministic = false) override;
+    void learn(const Observation& obs, int action, double reward, 
+              const Observation& next_obs, bool done) override;
+    void predict_batch(const Observation* observations, int n, int* actions,
+                       bool deterministic = false) override;
+    void greedy_actions(const Observation* observations, int n, int* actions) const override;
+    void learn_batch(const Observation* obs, const int* actions, const double* rewards,
+                     const Observation* next_obs, const uint8_t* dones, int n) override;
+    
+    void save_model(const std::string& filepath) override;
+    void load_model(const std::string& filepath) override;
+    
+    std::unique_ptr<RLAgent> clone() const override {
+        return std::make_unique<NeuralDQNAgent>(*this);
+    }
+    std::map<std::string, double> get_hyperparameters() const override;
+    void set_hyperparameters(const std::map<std::string, double>& params) override;
+    
+    // Getters
+    double get_learning_rate() const { return learning_rate; }
+    double get_epsilon() const { return epsilon; }
+    double get_gamma() const { return gamma; }
+    size_t get_replay_buffer_size() const { return replay_buffer.size(); }
+    size_t get_num_parameters() const { return main_network.num_parameters(); }
+    
+    // Setters
+    void set_epsilon(double new_epsilon) { epsilon = std::max(epsilon_min, new_epsilon); }
 };
 
 // Factory function to create agents
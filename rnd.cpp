@@ -26,9 +26,11 @@
  ***************************************************************************/
 #include "rnd.h"
  
-static std::mt19937 rng;
-static unsigned int rnd_number_of_call;
-static std::mt19937 rng_saved_state;
+// Generator state is per thread, so concurrent simulations draw independent
+// streams (each thread seeds its own with RNDInit)
+static thread_local std::mt19937 rng;
+static thread_local unsigned int rnd_number_of_call;
+static thread_local std::mt19937 rng_saved_state;
  
 long RNDInit(int seed){
 	 time_t t=time(NULL);
@@ -14,6 +14,10 @@
 #include <iomanip>
 #include <fstream>
 #include <sstream>
+#include <mutex>
+#include <random>
+#include <algorithm>
+#include <filesystem>
 
 #include "training_framework.h"
 #include "rl_agents.h"
@@ -25,20 +29,46 @@ void print_help() {
     std::cout << "Minority Game RL Training\n";
     std::cout << "Usage: train [options]\n\n";
     std::cout << "Options:\n";
-    std::cout << "  --agent TYPE          Agent type (random, qlearning, dqn) [default: qlearning]\n";
+    std::cout << "  --agent TYPE          Agent type (random, qlearning, dqn, neural_dqn) [default: qlearning]\n";
     std::cout << "  --episodes N          Number of training episodes [default: 1000]\n";
     std::cout << "  --players N           Number of players in the game [default: 101]\n";
     std::cout << "  --memory N            Memory size [default: 3]\n";
     std::cout << "  --lr RATE             Learning rate [default: 0.1]\n";
     std::cout << "  --epsilon EPS         Exploration rate [default: 0.1]\n";
     std::cout << "  --gamma GAMMA         Discount factor [default: 0.95]\n";
+    std::cout << "  --agent-params LIST   Extra agent parameters (e.g., \"prioritized_replay=1,batch_size=64\")\n";
+    std::cout << "  --epsilon-schedule S  Exploration decay (exponential, linear, step) [default: exponential]\n";
+    std::cout << "  --epsilon-per-step    Advance the exploration schedule every step instead of every episode\n";
     std::cout << "  --seed N              Random seed [default: random]\n";
+    std::cout << "  --reset-policy P      Population reset between episodes (full, keep, continue) [default: full]\n";
+    std::cout << "  --threads N           Single-agent qlearning: actor threads sharing one Q-table [default: 1]\n";
+    std::cout << "  --update-mode M       Shared Q-table updates with --threads (hogwild, striped) [default: hogwild]\n";
+    std::cout << "  --actor-learner       Single-agent: --threads actors feed one learner through a queue\n";
+    std::cout << "  --queue-capacity N    Actor-learner transition queue size [default: 65536]\n";
+    std::cout << "  --policy-sync N       Learned transitions between actor policy snapshots [default: 1000]\n";
     std::cout << "  --multiagent N        Train N RL agents simultaneously\n";
+    std::cout << "  --shared-policy       Multi-agent: all RL agents share one set of parameters\n";
+    std::cout << "  --eval-threads N      Threads for evaluation episodes, 0 for all cores [default: 1]\n";
+    std::cout << "  --rolling-window N    Episodes covered by rolling reward statistics [default: 100]\n";
+    std::cout << "  --metrics-flush N     Append metrics to disk every N episodes, 0 to write at the end [default: 100]\n";
+    std::cout << "  --metrics-format F    Training metrics file format (csv, binary) [default: csv]\n";
+    std::cout << "  --convert-metrics FILE Convert a binary metrics file to CSV (FILE with a .csv extension)\n";
     std::cout << "  --compare             Compare different agent types\n";
+    std::cout << "  --compare-seeds N     Seeds trained per agent type in --compare [default: 1]\n";
+    std::cout << "  --compare-save        Save models and metrics of every --compare run\n";
     std::cout << "  --evaluate FILE       Evaluate a saved model\n";
+    std::cout << "  --search SPEC         Hyperparameter search over agent parameters, e.g.\n";
+    std::cout << "                        \"learning_rate=0.01/0.05/0.1,epsilon=0.02~0.3\" (a/b/c grid, lo~hi sampled)\n";
+    std::cout << "  --search-samples N    Random draws of the lo~hi parameters per grid point [default: 10]\n";
+    std::cout << "  --search-min-episodes N Episodes of the first search rung; --episodes is the last [default: 50]\n";
+    std::cout << "  --search-eta N        Search keeps the best 1/N trials at each rung [default: 3]\n";
+    std::cout << "  --pbt N               Population-based training of N agents of --agent\n";
+    std::cout << "  --pbt-interval N      Episodes between population exploit steps [default: 50]\n";
     std::cout << "  --sweep PLAYERS       Sweep mode: train across multiple player counts (e.g., \"101,301,501\")\n";
     std::cout << "  --sweep-episodes N    Episodes for each sweep configuration [default: 1000]\n";
     std::cout << "  --eval-episodes N     Evaluation episodes for sweep [default: 500]\n";
+    std::cout << "  --sweep-seeds N       Seeds trained per sweep player count [default: 1]\n";
+    std::cout << "  --jobs N              Sweep, comparison, search or population runs in parallel, 0 for all cores [default: 1]\n";
     std::cout << "  --output-csv FILE     CSV output file for sweep results [default: sweep_results.csv]\n";
     std::cout << "  --verbose             Enable verbose output [default: true]\n";
     std::cout << "  --help                Show this help message\n";
@@ -61,6 +91,22 @@ std::map<std::string, std::string> parse_arguments(int argc, char* argv[]) {
     args["sweep-episodes"] = "1000";
     args["eval-episodes"] = "500";
     args["output-csv"] = "sweep_results.csv";
+    args["sweep-seeds"] = "1";
+    args["jobs"] = "1";
+    args["compare-seeds"] = "1";
+    args["search-samples"] = "10";
+    args["search-min-episodes"] = "50";
+    args["search-eta"] = "3";
+    args["pbt-interval"] = "50";
+    args["eval-threads"] = "1";
+    args["rolling-window"] = "100";
+    args["metrics-flush"] = "100";
+    args["metrics-format"] = "csv";
+    args["reset-policy"] = "full";
+    args["threads"] = "1";
+    args["update-mode"] = "hogwild";
+    args["queue-capacity"] = "65536";
+    args["policy-sync"] = "1000";
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -69,8 +115,16 @@ std::map<std::string, std::string> parse_arguments(int argc, char* argv[]) {
             args["help"] = "true";
         } else if (arg == "--compare") {
             args["compare"] = "true";
+        } else if (arg == "--compare-save") {
+            args["compare-save"] = "true";
         } else if (arg == "--verbose") {
             args["verbose"] = "true";
+        } else if (arg == "--shared-policy") {
+            args["shared-policy"] = "true";
+        } else if (arg == "--actor-learner") {
+            args["actor-learner"] = "true";
+        } else if (arg == "--epsilon-per-step") {
+            args["epsilon-per-step"] = "true";
         } else if (i + 1 < argc) {
             std::string value = argv[i + 1];
             
@@ -98,6 +152,27 @@ std::map<std::string, std::string> parse_arguments(int argc, char* argv[]) {
             } else if (arg == "--seed") {
                 args["seed"] = value;
                 i++;
+            } else if (arg == "--agent-params") {
+                args["agent-params"] = value;
+                i++;
+            } else if (arg == "--epsilon-schedule") {
+                args["epsilon-schedule"] = value;
+                i++;
+            } else if (arg == "--reset-policy") {
+                args["reset-policy"] = value;
+                i++;
+            } else if (arg == "--threads") {
+                args["threads"] = value;
+                i++;
+            } else if (arg == "--update-mode") {
+                args["update-mode"] = value;
+                i++;
+            } else if (arg == "--queue-capacity") {
+                args["queue-capacity"] = value;
+                i++;
+            } else if (arg == "--policy-sync") {
+                args["policy-sync"] = value;
+                i++;
             } else if (arg == "--multiagent") {
                 args["multiagent"] = value;
                 i++;
@@ -107,12 +182,54 @@ std::map<std::string, std::string> parse_arguments(int argc, char* argv[]) {
             } else if (arg == "--sweep") {
                 args["sweep"] = value;
                 i++;
+            } else if (arg == "--search") {
+                args["search"] = value;
+                i++;
+            } else if (arg == "--search-samples") {
+                args["search-samples"] = value;
+                i++;
+            } else if (arg == "--search-min-episodes") {
+                args["search-min-episodes"] = value;
+                i++;
+            } else if (arg == "--search-eta") {
+                args["search-eta"] = value;
+                i++;
+            } else if (arg == "--pbt") {
+                args["pbt"] = value;
+                i++;
+            } else if (arg == "--pbt-interval") {
+                args["pbt-interval"] = value;
+                i++;
             } else if (arg == "--sweep-episodes") {
                 args["sweep-episodes"] = value;
                 i++;
             } else if (arg == "--eval-episodes") {
                 args["eval-episodes"] = value;
                 i++;
+            } else if (arg == "--metrics-flush") {
+                args["metrics-flush"] = value;
+                i++;
+            } else if (arg == "--metrics-format") {
+                args["metrics-format"] = value;
+                i++;
+            } else if (arg == "--convert-metrics") {
+                args["convert-metrics"] = value;
+                i++;
+            } else if (arg == "--rolling-window") {
+                args["rolling-window"] = value;
+                i++;
+            } else if (arg == "--eval-threads") {
+                args["eval-threads"] = value;
+                i++;
+            } else if (arg == "--compare-seeds") {
+                args["compare-seeds"] = value;
+                i++;
+            } else if (arg == "--sweep-seeds") {
+                args["sweep-seeds"] = value;
+                i++;
+            } else if (arg == "--jobs") {
+                args["jobs"] = value;
+                i++;
             } else if (arg == "--output-csv") {
                 args["output-csv"] = value;
                 i++;
@@ -123,6 +240,30 @@ std::map<std::string, std::string> parse_arguments(int argc, char* argv[]) {
     return args;
 }
 
+// Apply comma-separated key=value pairs from --agent-params, and the
+// exploration schedule options
+void apply_agent_params(const std::map<std::string, std::string>& args,
+                        std::map<std::string, double>& params) {
+    if (args.find("epsilon-schedule") != args.end()) {
+        params["epsilon_schedule"] = (double)TrainingUtils::parse_schedule_type(args.at("epsilon-schedule"));
+    }
+    if (args.find("epsilon-per-step") != args.end()) {
+        params["epsilon_per_step"] = 1.0;
+    }
+    if (args.find("agent-params") == args.end()) return;
+    
+    std::stringstream ss(args.at("agent-params"));
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t eq_pos = item.find('=');
+        if (eq_pos == std::string::npos) {
+            std::cerr << "Warning: Invalid agent parameter '" << item << "', skipping." << std::endl;
+            continue;
+        }
+        params[item.substr(0, eq_pos)] = std::stod(item.substr(eq_pos + 1));
+    }
+}
+
 // Train a single agent
 void train_single_agent(const std::map<std::string, std::string>& args) {
     std::cout << "=== Single Agent Training ===" << std::endl;
@@ -136,6 +277,16 @@ void train_single_agent(const std::map<std::string, std::string>& args) {
     config.num_players = std::stoi(args.at("players"));
     config.memory_size = std::stoi(args.at("memory"));
     config.verbose = (args.at("verbose") == "true");
+    config.reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
+    config.num_threads = std::stoi(args.at("threads"));
+    config.shared_update_mode = TrainingUtils::parse_shared_update_mode(args.at("update-mode"));
+    config.actor_learner = (args.find("actor-learner") != args.end());
+    config.queue_capacity = std::stoi(args.at("queue-capacity"));
+    config.policy_sync_interval = std::max(1, std::stoi(args.at("policy-sync")));
+    config.eval_threads = std::stoi(args.at("eval-threads"));
+    config.rolling_window = std::stoi(args.at("rolling-window"));
+    config.metrics_flush_interval = std::stoi(args.at("metrics-flush"));
+    config.metrics_format = TrainingUtils::parse_metrics_format(args.at("metrics-format"));
     
     if (args.find("seed") != args.end()) {
         config.seed = std::stol(args.at("seed"));
@@ -145,6 +296,7 @@ void train_single_agent(const std::map<std::string, std::string>& args) {
     config.agent_params["learning_rate"] = std::stod(args.at("lr"));
     config.agent_params["epsilon"] = std::stod(args.at("epsilon"));
     config.agent_params["gamma"] = std::stod(args.at("gamma"));
+    apply_agent_params(args, config.agent_params);
     
     // Create and run trainer
     SingleAgentTrainer trainer(config);
@@ -170,6 +322,12 @@ void train_multi_agent(const std::map<std::string, std::string>& args) {
     config.num_rl_agents = num_rl_agents;
     config.memory_size = std::stoi(args.at("memory"));
     config.verbose = (args.at("verbose") == "true");
+    config.reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
+    config.share_parameters = (args.find("shared-policy") != args.end());
+    config.eval_threads = std::stoi(args.at("eval-threads"));
+    config.rolling_window = std::stoi(args.at("rolling-window"));
+    config.metrics_flush_interval = std::stoi(args.at("metrics-flush"));
+    config.metrics_format = TrainingUtils::parse_metrics_format(args.at("metrics-format"));
     
     if (args.find("seed") != args.end()) {
         config.seed = std::stol(args.at("seed"));
@@ -186,6 +344,7 @@ void train_multi_agent(const std::map<std::string, std::string>& args) {
         agent_params["learning_rate"] = std::stod(args.at("lr"));
         agent_params["epsilon"] = std::stod(args.at("epsilon"));
         agent_params["gamma"] = std::stod(args.at("gamma"));
+        apply_agent_params(args, agent_params);
         config.agent_params.push_back(agent_params);
     }
     
@@ -208,6 +367,7 @@ void compare_agents(const std::map<std::string, std::string>& args) {
     config.num_players = std::stoi(args.at("players"));
     config.memory_size = std::stoi(args.at("memory"));
     config.verbose = false; // Reduce output for comparison
+    config.reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
     
     if (args.find("seed") != args.end()) {
         config.seed = std::stol(args.at("seed"));
@@ -237,32 +397,161 @@ void compare_agents(const std::map<std::string, std::string>& args) {
     agent_params.push_back(dqn_params);
     
     // Run comparison
-    AgentComparator comparator(config);
+    int num_seeds = std::max(1, std::stoi(args.at("compare-seeds")));
+    int num_jobs = std::stoi(args.at("jobs"));
+    bool persist = (args.find("compare-save") != args.end());
+    std::cout << "Seeds per agent: " << num_seeds << ", parallel jobs: " 
+              << (num_jobs > 0 ? std::to_string(num_jobs) : "all cores") << std::endl;
+    
+    AgentComparator comparator(config, num_seeds, num_jobs, persist);
     std::vector<ComparisonResult> results = comparator.compare_agents(
         agent_types, agent_params, 100);
     
     comparator.print_comparison_results(results);
     
     // Save results
+    TrainingUtils::ensure_directory_exists("metrics/");
     std::string timestamp = TrainingUtils::get_timestamp_string();
     comparator.save_comparison_results(results, 
         "metrics/agent_comparison_" + timestamp + ".csv");
 }
 
+// Hyperparameter search over the agent parameters in --search
+void run_search(const std::map<std::string, std::string>& args) {
+    std::cout << "=== Hyperparameter Search ===" << std::endl;
+    
+    TrainingConfig config = TrainingUtils::create_default_single_config();
+    config.agent_type = args.at("agent");
+    config.num_players = std::stoi(args.at("players"));
+    config.memory_size = std::stoi(args.at("memory"));
+    config.reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
+    config.rolling_window = std::stoi(args.at("rolling-window"));
+    if (args.find("seed") != args.end()) {
+        config.seed = std::stol(args.at("seed"));
+    }
+    config.agent_params["learning_rate"] = std::stod(args.at("lr"));
+    config.agent_params["epsilon"] = std::stod(args.at("epsilon"));
+    config.agent_params["gamma"] = std::stod(args.at("gamma"));
+    apply_agent_params(args, config.agent_params);
+    
+    // Split the spec into grid values (a/b/c) and sampled ranges (lo~hi)
+    std::map<std::string, std::vector<double>> grid_values;
+    std::map<std::string, std::pair<double, double>> sample_ranges;
+    std::stringstream ss(args.at("search"));
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t eq_pos = item.find('=');
+        if (eq_pos == std::string::npos) {
+            std::cerr << "Warning: Invalid search parameter '" << item << "', skipping." << std::endl;
+            continue;
+        }
+        std::string name = item.substr(0, eq_pos);
+        std::string values = item.substr(eq_pos + 1);
+        size_t tilde_pos = values.find('~');
+        if (tilde_pos != std::string::npos) {
+            sample_ranges[name] = {std::stod(values.substr(0, tilde_pos)),
+                                   std::stod(values.substr(tilde_pos + 1))};
+        } else {
+            std::stringstream vs(values);
+            std::string value;
+            while (std::getline(vs, value, '/')) {
+                grid_values[name].push_back(std::stod(value));
+            }
+        }
+    }
+    
+    std::vector<std::map<std::string, double>> grid = TrainingUtils::create_parameter_grid(grid_values);
+    std::vector<std::map<std::string, double>> candidates;
+    if (sample_ranges.empty()) {
+        candidates = grid;
+    } else {
+        int num_samples = std::stoi(args.at("search-samples"));
+        long sample_seed = (config.seed >= 0) ? config.seed : 0;
+        for (size_t g = 0; g < grid.size(); g++) {
+            for (auto sample : TrainingUtils::sample_parameters(sample_ranges, num_samples,
+                                                                sample_seed + g)) {
+                sample.insert(grid[g].begin(), grid[g].end());
+                candidates.push_back(sample);
+            }
+        }
+    }
+    
+    int max_episodes = std::stoi(args.at("episodes"));
+    int min_episodes = std::stoi(args.at("search-min-episodes"));
+    int eta = std::stoi(args.at("search-eta"));
+    int num_jobs = std::stoi(args.at("jobs"));
+    std::cout << "Agent: " << config.agent_type << ", trials: " << candidates.size()
+              << ", episodes: " << min_episodes << " to " << max_episodes << " (eta " << eta << ")"
+              << ", parallel jobs: " << (num_jobs > 0 ? std::to_string(num_jobs) : "all cores") << std::endl;
+    
+    HyperparameterSearch search(config, num_jobs);
+    std::vector<SearchTrial> trials = search.run(candidates, min_episodes, max_episodes, eta);
+    search.print_results(trials);
+    
+    TrainingUtils::ensure_directory_exists("metrics/");
+    search.save_results(trials, "metrics/hyperparameter_search_" + 
+                        TrainingUtils::get_timestamp_string() + ".csv");
+}
+
+// Population-based training of --pbt agents
+void run_population_training(const std::map<std::string, std::string>& args) {
+    std::cout << "=== Population-Based Training ===" << std::endl;
+    
+    TrainingConfig config = TrainingUtils::create_default_single_config();
+    config.agent_type = args.at("agent");
+    config.num_players = std::stoi(args.at("players"));
+    config.memory_size = std::stoi(args.at("memory"));
+    config.verbose = (args.at("verbose") == "true");
+    config.reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
+    config.rolling_window = std::stoi(args.at("rolling-window"));
+    if (args.find("seed") != args.end()) {
+        config.seed = std::stol(args.at("seed"));
+    }
+    config.agent_params["learning_rate"] = std::stod(args.at("lr"));
+    config.agent_params["epsilon"] = std::stod(args.at("epsilon"));
+    config.agent_params["gamma"] = std::stod(args.at("gamma"));
+    apply_agent_params(args, config.agent_params);
+    
+    int population = std::stoi(args.at("pbt"));
+    int episodes = std::stoi(args.at("episodes"));
+    int interval = std::stoi(args.at("pbt-interval"));
+    int num_jobs = std::stoi(args.at("jobs"));
+    std::cout << "Agent: " << config.agent_type << ", population: " << population
+              << ", episodes: " << episodes << ", exploit every " << interval << " episodes"
+              << ", parallel jobs: " << (num_jobs > 0 ? std::to_string(num_jobs) : "all cores") << std::endl;
+    
+    TrainingUtils::ensure_directory_exists("metrics/");
+    TrainingUtils::ensure_directory_exists("models/");
+    std::string timestamp = TrainingUtils::get_timestamp_string();
+    
+    PopulationBasedTrainer pbt(config, population, num_jobs);
+    std::vector<PopulationMember> ranking = pbt.train(episodes, interval,
+                                                      "metrics/pbt_" + timestamp + ".csv");
+    pbt.print_results(ranking);
+    
+    // Keep the best member's agent
+    pbt.get_trainer(ranking[0].id).save_model("models/pbt_" + config.agent_type + "_" + 
+                                              timestamp + ".model");
+}
+
 // Evaluate a saved model
 void evaluate_model(const std::map<std::string, std::string>& args) {
     std::cout << "=== Model Evaluation ===" << std::endl;
     
     std::string model_path = args.at("evaluate");
     
-    // Create environment
-    MinorityGameEnv env(std::stoi(args.at("players")), 
-                       std::stoi(args.at("memory")), 2, 500, 10000, 0, 
-                       args.find("seed") != args.end() ? std::stol(args.at("seed")) : -1);
+    // Evaluation environment settings
+    TrainingConfig eval_config = TrainingUtils::create_default_single_config();
+    eval_config.num_players = std::stoi(args.at("players"));
+    eval_config.memory_size = std::stoi(args.at("memory"));
+    eval_config.reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
+    if (args.find("seed") != args.end()) {
+        eval_config.seed = std::stol(args.at("seed"));
+    }
     
     // Create agent and load model
     std::unique_ptr<RLAgent> agent = create_agent(args.at("agent"), 
-        env.get_observation_space_size(), env.get_action_space_size());
+        eval_config.memory_size, 2);
     
     try {
         agent->load_model(model_path);
@@ -273,33 +562,11 @@ void evaluate_model(const std::map<std::string, std::string>& args) {
     }
     
     // Evaluate
-    std::vector<double> eval_rewards;
-    std::vector<double> eval_win_rates;
     int num_episodes = 100;
-    
-    for (int episode = 0; episode < num_episodes; episode++) {
-        Observation obs = env.reset();
-        double total_reward = 0.0;
-        
-        for (int step = 0; step < 10000; step++) {
-            int action = agent->predict(obs, true); // Deterministic
-            auto [next_obs, reward, terminated, info] = env.step(action);
-            
-            obs = next_obs;
-            total_reward += reward;
-            
-            if (terminated) {
-                eval_rewards.push_back(total_reward);
-                eval_win_rates.push_back(info.win_rate);
-                break;
-            }
-        }
-        
-        if ((episode + 1) % 20 == 0) {
-            std::cout << "Evaluated " << (episode + 1) << "/" << num_episodes 
-                      << " episodes..." << std::endl;
-        }
-    }
+    EvaluationResult result = TrainingUtils::evaluate_policy(*agent, eval_config, num_episodes,
+                                                             std::stoi(args.at("eval-threads")));
+    const std::vector<double>& eval_rewards = result.rewards;
+    const std::vector<double>& eval_win_rates = result.win_rates;
     
     double avg_reward = TrainingUtils::calculate_mean(eval_rewards);
     double std_reward = TrainingUtils::calculate_std(eval_rewards);
@@ -337,10 +604,20 @@ std::vector<int> parse_player_counts(const std::string& players_str) {
 }
 
 // Generate model filename for sweep
-std::string generate_sweep_model_filename(const std::string& agent_type, int memory, int players) {
-    return agent_type + "_agent_m" + std::to_string(memory) + "_n" + std::to_string(players) + ".model";
+std::string generate_sweep_model_filename(const std::string& agent_type, int memory, int players,
+                                          int seed_index = 0) {
+    std::string seed_suffix = (seed_index > 0) ? "_s" + std::to_string(seed_index) : "";
+    return agent_type + "_agent_m" + std::to_string(memory) + "_n" + std::to_string(players) +
+           seed_suffix + ".model";
 }
 
+// One (player count, seed) configuration of a sweep
+struct SweepJob {
+    int num_players;
+    int seed_index;
+    long seed;
+};
+
 // Sweep training across multiple player configurations
 void run_sweep_training(const std::map<std::string, std::string>& args) {
     std::cout << "=== Parameter Sweep Training ===" << std::endl;
@@ -357,16 +634,26 @@ void run_sweep_training(const std::map<std::string, std::string>& args) {
     int memory_size = std::stoi(args.at("memory"));
     int sweep_episodes = std::stoi(args.at("sweep-episodes"));
     int eval_episodes = std::stoi(args.at("eval-episodes"));
+    int sweep_seeds = std::max(1, std::stoi(args.at("sweep-seeds")));
+    int num_jobs = std::stoi(args.at("jobs"));
+    int eval_threads = std::stoi(args.at("eval-threads"));
     std::string output_csv = args.at("output-csv");
     bool verbose = (args.at("verbose") == "true");
+    ResetPolicy reset_policy = TrainingUtils::parse_reset_policy(args.at("reset-policy"));
     
     double learning_rate = std::stod(args.at("lr"));
     double epsilon = std::stod(args.at("epsilon"));
     double gamma = std::stod(args.at("gamma"));
     
-    long seed = -1;
-    if (args.find("seed") != args.end()) {
-        seed = std::stol(args.at("seed"));
+    // Jobs seed their own RND stream, so an unseeded sweep still needs a base seed
+    long seed = (args.find("seed") != args.end()) ? std::stol(args.at("seed")) :
+                (long)(std::random_device{}() & 0x3fffffff);
+    
+    std::vector<SweepJob> jobs;
+    for (int num_players : player_counts) {
+        for (int s = 0; s < sweep_seeds; s++) {
+            jobs.push_back({num_players, s, seed + s});
+        }
     }
     
     std::cout << "Sweep Configuration:" << std::endl;
@@ -378,6 +665,8 @@ void run_sweep_training(const std::map<std::string, std::string>& args) {
         if (i < player_counts.size() - 1) std::cout << ", ";
     }
     std::cout << std::endl;
+    std::cout << "  Seeds per Player Count: " << sweep_seeds << " (base seed " << seed << ")" << std::endl;
+    std::cout << "  Parallel Jobs: " << (num_jobs > 0 ? std::to_string(num_jobs) : "all cores") << std::endl;
     std::cout << "  Training Episodes: " << sweep_episodes << std::endl;
     std::cout << "  Evaluation Episodes: " << eval_episodes << std::endl;
     std::cout << "  Output CSV: " << output_csv << std::endl;
@@ -392,11 +681,25 @@ void run_sweep_training(const std::map<std::string, std::string>& args) {
     
     csv_file << "agent_type,memory_size,num_players,learning_rate,epsilon,gamma,";
     csv_file << "average_reward,std_reward,win_rate,std_win_rate,";
-    csv_file << "non_rl_avg_win_rate,non_rl_std_win_rate,model_filename" << std::endl;
+    csv_file << "non_rl_avg_win_rate,non_rl_std_win_rate,model_filename,seed" << std::endl;
     
-    // Run sweep for each player count
-    for (int num_players : player_counts) {
-        std::cout << "\n--- Training with " << num_players << " players ---" << std::endl;
+    TrainingUtils::ensure_directory_exists("sweep_models/");
+    
+    // Console report and CSV row of a finished job are written together
+    std::mutex output_mutex;
+    
+    // Only a sequential sweep prints per-episode progress
+    bool job_verbose = verbose && (num_jobs == 1 || jobs.size() == 1);
+    
+    TrainingUtils::parallel_for(jobs.size(), num_jobs, [&](int job_index) {
+        const SweepJob& job = jobs[job_index];
+        int num_players = job.num_players;
+        
+        {
+            std::lock_guard<std::mutex> guard(output_mutex);
+            std::cout << "\n--- Training with " << num_players << " players (seed " 
+                      << job.seed << ") ---" << std::endl;
+        }
         
         // Create training configuration
         TrainingConfig config = TrainingUtils::create_default_single_config();
@@ -404,75 +707,56 @@ void run_sweep_training(const std::map<std::string, std::string>& args) {
         config.episodes = sweep_episodes;
         config.num_players = num_players;
         config.memory_size = memory_size;
-        config.verbose = verbose;
-        config.seed = seed;
+        config.verbose = job_verbose;
+        config.seed = job.seed;
+        config.reset_policy = reset_policy;
         
         // Set agent parameters
         config.agent_params["learning_rate"] = learning_rate;
         config.agent_params["epsilon"] = epsilon;
         config.agent_params["gamma"] = gamma;
+        apply_agent_params(args, config.agent_params);
         
-        // Generate model filename
-        std::string model_filename = generate_sweep_model_filename(agent_type, memory_size, num_players);
+        // Each job writes only its own model and metrics files
+        std::string model_filename = generate_sweep_model_filename(agent_type, memory_size, num_players,
+                                                                   job.seed_index);
         config.model_save_path = "sweep_models/";
+        config.metrics_save_path = "metrics/sweep_n" + std::to_string(num_players) + "_s" + 
+                                   std::to_string(job.seed_index) + "/";
+        config.save_model = false;
         
+        std::ostringstream row;
         try {
             // Create and train agent
             SingleAgentTrainer trainer(config);
-            std::cout << "Training agent..." << std::endl;
             TrainingMetrics training_metrics = trainer.train();
             
             // Save the trained model
-            std::cout << "Saving model to: " << model_filename << std::endl;
             trainer.save_model("sweep_models/" + model_filename);
             
-            // Evaluate the trained agent
-            std::cout << "Evaluating agent over " << eval_episodes << " episodes..." << std::endl;
-            
-            // Create evaluation environment
-            MinorityGameEnv eval_env(num_players, memory_size, 2, 500, 10000, 0, seed);
-            RLAgent* agent = trainer.get_agent();
-            
-            std::vector<double> eval_rewards;
-            std::vector<double> eval_win_rates;
-            std::vector<double> non_rl_std_win_rates_vec;
-            
-            for (int episode = 0; episode < eval_episodes; episode++) {
-                Observation obs = eval_env.reset();
-                double total_reward = 0.0;
-                
-                for (int step = 0; step < 10000; step++) {
-                    int action = agent->predict(obs, true); // Deterministic evaluation
-                    auto [next_obs, reward, terminated, info] = eval_env.step(action);
-                    
-                    obs = next_obs;
-                    total_reward += reward;
-                    
-                    if (terminated) {
-                        eval_rewards.push_back(total_reward);
-                        eval_win_rates.push_back(info.win_rate);
-                        non_rl_std_win_rates_vec.push_back(eval_env.get_non_rl_std_win_rate());
-                        break;
-                    }
-                }
-                
-                if (verbose && (episode + 1) % 100 == 0) {
-                    std::cout << "  Evaluated " << (episode + 1) << "/" << eval_episodes 
-                              << " episodes..." << std::endl;
-                }
-            }
+            // Evaluate the trained policy on fresh environments
+            EvaluationResult eval = TrainingUtils::evaluate_policy(*trainer.get_agent(), config,
+                                                                   eval_episodes, eval_threads);
             
             // Calculate statistics
-            double avg_reward = TrainingUtils::calculate_mean(eval_rewards);
-            double std_reward = TrainingUtils::calculate_std(eval_rewards);
-            double avg_win_rate = TrainingUtils::calculate_mean(eval_win_rates);
-            double std_win_rate = TrainingUtils::calculate_std(eval_win_rates);
+            double avg_reward = TrainingUtils::calculate_mean(eval.rewards);
+            double std_reward = TrainingUtils::calculate_std(eval.rewards);
+            double avg_win_rate = TrainingUtils::calculate_mean(eval.win_rates);
+            double std_win_rate = TrainingUtils::calculate_std(eval.win_rates);
             
-            double non_rl_avg_wr = eval_env.get_non_rl_avg_win_rate();
-            double non_rl_std_wr = TrainingUtils::calculate_mean(non_rl_std_win_rates_vec);
+            double non_rl_avg_wr = TrainingUtils::calculate_mean(eval.non_rl_avg_win_rates);
+            double non_rl_std_wr = TrainingUtils::calculate_mean(eval.non_rl_std_win_rates);
+            
+            row << agent_type << "," << memory_size << "," << num_players << ",";
+            row << learning_rate << "," << epsilon << "," << gamma << ",";
+            row << std::fixed << std::setprecision(6) << avg_reward << "," << std_reward << ",";
+            row << avg_win_rate << "," << std_win_rate << ",";
+            row << non_rl_avg_wr << "," << non_rl_std_wr << ",";
+            row << model_filename << "," << job.seed;
             
             // Print results
-            std::cout << "Results for " << num_players << " players:" << std::endl;
+            std::lock_guard<std::mutex> guard(output_mutex);
+            std::cout << "Results for " << num_players << " players (seed " << job.seed << "):" << std::endl;
             std::cout << "  Average Reward: " << std::fixed << std::setprecision(4) 
                       << avg_reward << " ± " << std_reward << std::endl;
             std::cout << "  Win Rate: " << std::fixed << std::setprecision(2) 
@@ -482,23 +766,18 @@ void run_sweep_training(const std::map<std::string, std::string>& args) {
             std::cout << "  Non-RL Std Win Rate: " << std::fixed << std::setprecision(2) 
                       << non_rl_std_wr * 100 << "%" << std::endl;
             std::cout << "  Model saved as: " << model_filename << std::endl;
-            
-            csv_file << agent_type << "," << memory_size << "," << num_players << ",";
-            csv_file << learning_rate << "," << epsilon << "," << gamma << ",";
-            csv_file << std::fixed << std::setprecision(6) << avg_reward << "," << std_reward << ",";
-            csv_file << avg_win_rate << "," << std_win_rate << ",";
-            csv_file << non_rl_avg_wr << "," << non_rl_std_wr << ",";
-            csv_file << model_filename << std::endl;
+            csv_file << row.str() << std::endl;
             
         } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> guard(output_mutex);
             std::cerr << "Error training with " << num_players << " players: " << e.what() << std::endl;
             
             // Write error entry to CSV
             csv_file << agent_type << "," << memory_size << "," << num_players << ",";
             csv_file << learning_rate << "," << epsilon << "," << gamma << ",";
-            csv_file << "ERROR,ERROR,ERROR,ERROR,ERROR,ERROR,ERROR" << std::endl;
+            csv_file << "ERROR,ERROR,ERROR,ERROR,ERROR,ERROR,ERROR," << job.seed << std::endl;
         }
-    }
+    });
     
     csv_file.close();
     
@@ -507,6 +786,18 @@ void run_sweep_training(const std::map<std::string, std::string>& args) {
     std::cout << "Models saved in: sweep_models/" << std::endl;
 }
 
+// Convert a binary metrics file to CSV
+void convert_metrics(const std::map<std::string, std::string>& args) {
+    std::string input = args.at("convert-metrics");
+    std::string output = std::filesystem::path(input).replace_extension(".csv").string();
+    
+    MetricsFileReader reader(input);
+    reader.write_csv(output);
+    
+    std::cout << "Converted " << reader.num_rows() << " episodes from " << input 
+              << " to " << output << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     std::cout << "Minority Game RL Training System" << std::endl;
     std::cout << "================================" << std::endl;
@@ -532,10 +823,16 @@ int main(int argc, char* argv[]) {
     
     try {
         // Determine what to do based on arguments
-        if (args.find("evaluate") != args.end()) {
+        if (args.find("convert-metrics") != args.end()) {
+            convert_metrics(args);
+        } else if (args.find("evaluate") != args.end()) {
             evaluate_model(args);
         } else if (args.find("compare") != args.end()) {
             compare_agents(args);
+        } else if (args.find("search") != args.end()) {
+            run_search(args);
+        } else if (args.find("pbt") != args.end()) {
+            run_population_training(args);
         } else if (args.find("multiagent") != args.end()) {
             train_multi_agent(args);
         } else if (args.find("sweep") != args.end()) {
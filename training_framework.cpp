@@ -6,6 +6,7 @@
  ***************************************************************************/
 
 #include "training_framework.h"
+#include "mpsc_queue.h"
 #include "rnd.h"
 #include <iostream>
 #include <iomanip>
@@ -14,10 +15,130 @@
 #include <numeric>
 #include <cmath>
 #include <filesystem>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <set>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// RollingStatistics Implementation
+
+static inline void kahan_add(double& sum, double& compensation, double value) {
+    double y = value - compensation;
+    double t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+}
+
+RollingStatistics::RollingStatistics(int window)
+    : window(std::max(1, window)), ema_alpha(2.0 / (std::max(1, window) + 1)),
+      buffer(std::max(1, window), 0.0), next(0), count(0), adds_since_renormalize(0),
+      total_added(0), sum(0.0), sum_compensation(0.0), sum_sq(0.0), sum_sq_compensation(0.0),
+      ema_value(0.0) {}
+
+void RollingStatistics::add(double value) {
+    if (count == window) {
+        double old = buffer[next];
+        kahan_add(sum, sum_compensation, -old);
+        kahan_add(sum_sq, sum_sq_compensation, -old * old);
+    } else {
+        count++;
+    }
+    buffer[next] = value;
+    next = (next + 1) % window;
+    kahan_add(sum, sum_compensation, value);
+    kahan_add(sum_sq, sum_sq_compensation, value * value);
+    
+    // Drop candidates that can no longer be the extreme, then expired ones
+    while (!min_candidates.empty() && min_candidates.back().second >= value) {
+        min_candidates.pop_back();
+    }
+    min_candidates.push_back({total_added, value});
+    while (!max_candidates.empty() && max_candidates.back().second <= value) {
+        max_candidates.pop_back();
+    }
+    max_candidates.push_back({total_added, value});
+    long oldest = total_added - window + 1;
+    if (min_candidates.front().first < oldest) min_candidates.pop_front();
+    if (max_candidates.front().first < oldest) max_candidates.pop_front();
+    
+    ema_value = (total_added == 0) ? value : ema_value + ema_alpha * (value - ema_value);
+    total_added++;
+    
+    if (++adds_since_renormalize >= window) {
+        renormalize();
+    }
+}
+
+void RollingStatistics::renormalize() {
+    sum = sum_compensation = 0.0;
+    sum_sq = sum_sq_compensation = 0.0;
+    for (int i = 0; i < count; i++) {
+        kahan_add(sum, sum_compensation, buffer[i]);
+        kahan_add(sum_sq, sum_sq_compensation, buffer[i] * buffer[i]);
+    }
+    adds_since_renormalize = 0;
+}
+
+void RollingStatistics::clear() {
+    next = count = adds_since_renormalize = 0;
+    total_added = 0;
+    sum = sum_compensation = sum_sq = sum_sq_compensation = 0.0;
+    ema_value = 0.0;
+    min_candidates.clear();
+    max_candidates.clear();
+}
+
+double RollingStatistics::mean() const {
+    return count > 0 ? sum / count : 0.0;
+}
+
+double RollingStatistics::std() const {
+    if (count <= 1) return 0.0;
+    double variance = (sum_sq - sum * sum / count) / (count - 1);
+    return std::sqrt(std::max(0.0, variance));
+}
+
+double RollingStatistics::min() const {
+    return min_candidates.empty() ? 0.0 : min_candidates.front().second;
+}
+
+double RollingStatistics::max() const {
+    return max_candidates.empty() ? 0.0 : max_candidates.front().second;
+}
 
 // TrainingMetrics Implementation
 
+std::vector<MetricsColumn> TrainingMetrics::columns() {
+    return {"reward", "win_rate", "average_reward", {"episode_length", MetricsColumnType::INT32}};
+}
+
 void TrainingMetrics::save_to_file(const std::string& filepath) const {
+    if (TrainingUtils::metrics_format_for_path(filepath) == MetricsFormat::BINARY) {
+        MetricsStreamWriter writer(filepath, columns(), std::max<size_t>(1, episode_rewards.size()),
+                                   false, MetricsFormat::BINARY);
+        for (size_t i = 0; i < episode_rewards.size(); i++) {
+            writer.add_row({episode_rewards[i], win_rates[i],
+                            i < average_rewards.size() ? average_rewards[i] : 0.0,
+                            i < episode_lengths.size() ? (double)episode_lengths[i] : 0.0});
+        }
+        writer.close(training_time.count());
+        std::cout << "Training metrics saved to " << filepath << std::endl;
+        return;
+    }
+    
     std::ofstream file(filepath);
     if (file.is_open()) {
         file << "episode,reward,win_rate,average_reward,episode_length\n";
@@ -41,6 +162,42 @@ void TrainingMetrics::save_to_file(const std::string& filepath) const {
 }
 
 void TrainingMetrics::load_from_file(const std::string& filepath) {
+    if (MetricsFileReader::is_binary_file(filepath)) {
+        MetricsFileReader reader(filepath);
+        int reward_column = reader.column_index("reward");
+        int win_rate_column = reader.column_index("win_rate");
+        int average_column = reader.column_index("average_reward");
+        int length_column = reader.column_index("episode_length");
+        if (reward_column < 0 || win_rate_column < 0) {
+            throw std::runtime_error("Not a single-agent metrics file: " + filepath);
+        }
+        
+        episode_rewards = reader.read_column(reward_column);
+        win_rates = reader.read_column(win_rate_column);
+        average_rewards.clear();
+        if (average_column >= 0) {
+            average_rewards = reader.read_column(average_column);
+        }
+        episode_lengths.clear();
+        if (length_column >= 0) {
+            for (double length : reader.read_column(length_column)) {
+                episode_lengths.push_back((int)length);
+            }
+        }
+        
+        reward_stats.clear();
+        win_rate_stats.clear();
+        for (size_t i = 0; i < episode_rewards.size(); i++) {
+            reward_stats.add(episode_rewards[i]);
+            win_rate_stats.add(win_rates[i]);
+        }
+        if (reader.get_training_time() >= 0.0) {
+            training_time = std::chrono::duration<double>(reader.get_training_time());
+        }
+        std::cout << "Training metrics loaded from " << filepath << std::endl;
+        return;
+    }
+    
     std::ifstream file(filepath);
     if (file.is_open()) {
         std::string line;
@@ -50,6 +207,8 @@ void TrainingMetrics::load_from_file(const std::string& filepath) {
         win_rates.clear();
         average_rewards.clear();
         episode_lengths.clear();
+        reward_stats.clear();
+        win_rate_stats.clear();
         
         while (std::getline(file, line)) {
             if (line.find("training_time_seconds") != std::string::npos) {
@@ -72,6 +231,8 @@ void TrainingMetrics::load_from_file(const std::string& filepath) {
             if (tokens.size() >= 5) {
                 episode_rewards.push_back(std::stod(tokens[1]));
                 win_rates.push_back(std::stod(tokens[2]));
+                reward_stats.add(episode_rewards.back());
+                win_rate_stats.add(win_rates.back());
                 if (!tokens[3].empty()) {
                     average_rewards.push_back(std::stod(tokens[3]));
                 }
@@ -107,21 +268,476 @@ void TrainingMetrics::print_summary() const {
     std::cout << "Average Win Rate: " << std::fixed << std::setprecision(1) 
               << avg_win_rate * 100 << "% ± " << std_win_rate * 100 << "%" << std::endl;
     
-    if (!average_rewards.empty()) {
-        std::cout << "Final 100-episode Average: " << std::fixed << std::setprecision(3)
-                  << average_rewards.back() << std::endl;
+    if (reward_stats.size() > 0) {
+        std::cout << "Final " << reward_stats.size() << "-episode Average: " << std::fixed 
+                  << std::setprecision(3) << reward_stats.mean() << " ± " << reward_stats.std()
+                  << " (min " << reward_stats.min() << ", max " << reward_stats.max() << ")" << std::endl;
+        std::cout << "Final " << reward_stats.size() << "-episode Win Rate: " << std::fixed 
+                  << std::setprecision(1) << win_rate_stats.mean() * 100 << "% ± " 
+                  << win_rate_stats.std() * 100 << "%" << std::endl;
+        std::cout << "Reward EMA: " << std::fixed << std::setprecision(3) 
+                  << reward_stats.ema() << std::endl;
     }
     std::cout << "========================\n" << std::endl;
 }
 
+// Binary metrics format constants (see MetricsFormat)
+
+static const char METRICS_MAGIC[8] = {'M', 'G', 'M', 'E', 'T', 'R', 'I', 'C'};
+static const uint32_t METRICS_VERSION = 1;
+static const uint32_t METRICS_CHUNK_TAG = 0x4B4E4843;  // "CHNK"
+static const uint32_t METRICS_TIME_TAG = 0x454D4954;   // "TIME"
+
+static bool host_is_little_endian() {
+    uint16_t probe = 1;
+    unsigned char first_byte;
+    std::memcpy(&first_byte, &probe, 1);
+    return first_byte == 1;
+}
+
+template <typename T>
+static void append_le(std::vector<char>& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (!host_is_little_endian()) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static T load_le(const char* in) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, in, sizeof(T));
+    if (!host_is_little_endian()) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+static size_t padded_to_8(size_t bytes) {
+    return (bytes + 7) & ~(size_t)7;
+}
+
+static size_t column_type_size(MetricsColumnType type) {
+    return type == MetricsColumnType::INT32 ? sizeof(int32_t) : sizeof(double);
+}
+
+// MetricsStreamWriter Implementation
+
+MetricsStreamWriter::MetricsStreamWriter(const std::string& filepath,
+                                         const std::vector<MetricsColumn>& columns,
+                                         int flush_interval, bool append, MetricsFormat format)
+    : filepath(filepath), columns(columns), format(format),
+      flush_interval(std::max(1, flush_interval)), next_episode(0), writing(false),
+      stopping(false) {
+    
+    // Continue the episode numbering of an existing file
+    if (append && std::filesystem::exists(filepath) && std::filesystem::file_size(filepath) > 0) {
+        if (format == MetricsFormat::BINARY) {
+            MetricsFileReader existing(filepath);
+            if (existing.num_columns() != (int)columns.size() + 1) {
+                throw std::runtime_error("Cannot append to metrics file with other columns: " + filepath);
+            }
+            next_episode = existing.num_rows();
+        } else {
+            std::ifstream existing(filepath);
+            std::string line;
+            std::getline(existing, line);
+            while (std::getline(existing, line)) {
+                if (!line.empty() && line.find("training_time_seconds") == std::string::npos) {
+                    next_episode++;
+                }
+            }
+        }
+    }
+    
+    bool extend = append && std::filesystem::exists(filepath) && 
+                  std::filesystem::file_size(filepath) > 0;
+    std::ios::openmode mode = std::ios::binary | (extend ? std::ios::app : std::ios::trunc);
+    file.open(filepath, mode);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file for writing: " + filepath);
+    }
+    if (!extend) {
+        write_header();
+    }
+    
+    writer_thread = std::thread(&MetricsStreamWriter::write_loop, this);
+}
+
+MetricsStreamWriter::~MetricsStreamWriter() {
+    close();
+}
+
+void MetricsStreamWriter::write_header() {
+    if (format == MetricsFormat::BINARY) {
+        std::vector<char> out(METRICS_MAGIC, METRICS_MAGIC + sizeof(METRICS_MAGIC));
+        append_le<uint32_t>(out, METRICS_VERSION);
+        append_le<uint32_t>(out, columns.size() + 1);
+        append_le<uint32_t>(out, (uint32_t)MetricsColumnType::INT32);
+        append_le<uint32_t>(out, 7);
+        out.insert(out.end(), "episode", "episode" + 7);
+        for (const MetricsColumn& column : columns) {
+            append_le<uint32_t>(out, (uint32_t)column.type);
+            append_le<uint32_t>(out, column.name.size());
+            out.insert(out.end(), column.name.begin(), column.name.end());
+        }
+        out.resize(padded_to_8(out.size()), 0);
+        file.write(out.data(), out.size());
+    } else {
+        file << "episode";
+        for (const MetricsColumn& column : columns) {
+            file << "," << column.name;
+        }
+        file << "\n";
+    }
+    file.flush();
+}
+
+void MetricsStreamWriter::add_row(const std::vector<double>& values) {
+    size_t n = std::min(columns.size(), values.size());
+    pending.insert(pending.end(), values.begin(), values.begin() + n);
+    pending.resize(pending.size() + columns.size() - n, 0.0);
+    if (pending.size() >= (size_t)flush_interval * columns.size()) {
+        flush();
+    }
+}
+
+void MetricsStreamWriter::flush(bool wait) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!pending.empty()) {
+        long rows = pending.size() / columns.size();
+        batch_first_episodes.push_back(next_episode);
+        batches.push_back(std::move(pending));
+        pending.clear();
+        next_episode += rows;
+        work_ready.notify_one();
+    }
+    if (wait) {
+        work_done.wait(lock, [&] { return batches.empty() && !writing; });
+    }
+}
+
+void MetricsStreamWriter::write_rows(const std::vector<double>& batch, long first_episode) {
+    size_t num_columns = columns.size();
+    size_t rows = batch.size() / num_columns;
+    
+    if (format == MetricsFormat::BINARY) {
+        // One chunk, column by column
+        std::vector<char> out;
+        size_t bytes = 8 + padded_to_8(rows * sizeof(int32_t));
+        for (const MetricsColumn& column : columns) {
+            bytes += padded_to_8(rows * column_type_size(column.type));
+        }
+        out.reserve(bytes);
+        
+        append_le<uint32_t>(out, METRICS_CHUNK_TAG);
+        append_le<uint32_t>(out, rows);
+        for (size_t r = 0; r < rows; r++) {
+            append_le<int32_t>(out, first_episode + r);
+        }
+        out.resize(padded_to_8(out.size()), 0);
+        for (size_t c = 0; c < num_columns; c++) {
+            for (size_t r = 0; r < rows; r++) {
+                double value = batch[r * num_columns + c];
+                if (columns[c].type == MetricsColumnType::INT32) {
+                    append_le<int32_t>(out, (int32_t)std::llround(value));
+                } else {
+                    append_le<double>(out, value);
+                }
+            }
+            out.resize(padded_to_8(out.size()), 0);
+        }
+        file.write(out.data(), out.size());
+    } else {
+        for (size_t r = 0; r < rows; r++) {
+            file << first_episode + r;
+            for (size_t c = 0; c < num_columns; c++) {
+                double value = batch[r * num_columns + c];
+                if (columns[c].type == MetricsColumnType::INT32) {
+                    file << "," << std::llround(value);
+                } else {
+                    file << "," << value;
+                }
+            }
+            file << "\n";
+        }
+    }
+    file.flush();
+}
+
+void MetricsStreamWriter::write_loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        work_ready.wait(lock, [&] { return stopping || !batches.empty(); });
+        if (batches.empty()) break;
+        
+        std::vector<double> batch = std::move(batches.front());
+        long first_episode = batch_first_episodes.front();
+        batches.pop_front();
+        batch_first_episodes.pop_front();
+        writing = true;
+        lock.unlock();
+        
+        // Format and write outside the lock so the trainer never waits on I/O
+        write_rows(batch, first_episode);
+        
+        lock.lock();
+        writing = false;
+        work_done.notify_all();
+    }
+}
+
+void MetricsStreamWriter::close(double training_time_seconds) {
+    if (!writer_thread.joinable()) return;
+    
+    flush();
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+    }
+    work_ready.notify_one();
+    writer_thread.join();
+    
+    if (training_time_seconds >= 0.0) {
+        if (format == MetricsFormat::BINARY) {
+            std::vector<char> out;
+            append_le<uint32_t>(out, METRICS_TIME_TAG);
+            append_le<uint32_t>(out, 0);
+            append_le<double>(out, training_time_seconds);
+            file.write(out.data(), out.size());
+        } else {
+            file << "training_time_seconds," << training_time_seconds << "\n";
+        }
+    }
+    file.close();
+}
+
+// MetricsFileReader Implementation
+
+MetricsFileReader::MetricsFileReader(const std::string& filepath)
+    : data(nullptr), size(0),
+#ifdef _WIN32
+      file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr),
+#else
+      fd(-1),
+#endif
+      total_rows(0), training_time(-1.0) {
+    
+    if (!host_is_little_endian()) {
+        throw std::runtime_error("Memory-mapped metrics files need a little-endian host");
+    }
+    
+#ifdef _WIN32
+    file_handle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open file for reading: " + filepath);
+    }
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file_handle, &file_size);
+    size = file_size.QuadPart;
+    if (size > 0) {
+        mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle) {
+            data = (const char*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+#else
+    fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file for reading: " + filepath);
+    }
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+    size = file_stat.st_size;
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            data = (const char*)mapping;
+        }
+    }
+#endif
+    
+    if (!data) {
+        unmap();
+        throw std::runtime_error("Could not memory-map metrics file: " + filepath);
+    }
+    
+    try {
+        parse();
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+MetricsFileReader::~MetricsFileReader() {
+    unmap();
+}
+
+void MetricsFileReader::unmap() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mapping_handle) CloseHandle(mapping_handle);
+    if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+    mapping_handle = nullptr;
+    file_handle = INVALID_HANDLE_VALUE;
+#else
+    if (data) munmap((void*)data, size);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    data = nullptr;
+}
+
+void MetricsFileReader::parse() {
+    if (size < 16 || std::memcmp(data, METRICS_MAGIC, sizeof(METRICS_MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary metrics file");
+    }
+    if (load_le<uint32_t>(data + 8) != METRICS_VERSION) {
+        throw std::runtime_error("Unsupported binary metrics version");
+    }
+    
+    uint32_t count = load_le<uint32_t>(data + 12);
+    size_t pos = 16;
+    for (uint32_t c = 0; c < count; c++) {
+        if (pos + 8 > size) throw std::runtime_error("Truncated metrics header");
+        uint32_t type = load_le<uint32_t>(data + pos);
+        uint32_t name_length = load_le<uint32_t>(data + pos + 4);
+        pos += 8;
+        if (type > (uint32_t)MetricsColumnType::INT32 || pos + name_length > size) {
+            throw std::runtime_error("Corrupt metrics header");
+        }
+        columns.emplace_back(std::string(data + pos, name_length), (MetricsColumnType)type);
+        pos += name_length;
+    }
+    pos = padded_to_8(pos);
+    
+    // Index the chunks; a partially written one ends the data
+    while (pos + 8 <= size) {
+        uint32_t tag = load_le<uint32_t>(data + pos);
+        if (tag == METRICS_TIME_TAG) {
+            if (pos + 16 <= size) {
+                training_time = load_le<double>(data + pos + 8);
+            }
+            break;
+        }
+        if (tag != METRICS_CHUNK_TAG) break;
+        
+        long rows = load_le<uint32_t>(data + pos + 4);
+        size_t column_pos = pos + 8;
+        std::vector<const char*> column_data;
+        for (const MetricsColumn& column : columns) {
+            column_data.push_back(data + column_pos);
+            column_pos += padded_to_8(rows * column_type_size(column.type));
+        }
+        if (column_pos > size) break;
+        
+        chunk_first_rows.push_back(total_rows);
+        chunk_rows.push_back(rows);
+        chunk_columns.push_back(std::move(column_data));
+        total_rows += rows;
+        pos = column_pos;
+    }
+}
+
+bool MetricsFileReader::is_binary_file(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    char magic[sizeof(METRICS_MAGIC)];
+    return file.read(magic, sizeof(magic)) && 
+           std::memcmp(magic, METRICS_MAGIC, sizeof(METRICS_MAGIC)) == 0;
+}
+
+int MetricsFileReader::column_index(const std::string& name) const {
+    for (size_t c = 0; c < columns.size(); c++) {
+        if (columns[c].name == name) return c;
+    }
+    return -1;
+}
+
+const double* MetricsFileReader::float64_column(int column, int chunk) const {
+    if (columns[column].type != MetricsColumnType::FLOAT64) {
+        throw std::invalid_argument("Column " + columns[column].name + " is not float64");
+    }
+    return reinterpret_cast<const double*>(chunk_columns[chunk][column]);
+}
+
+const int32_t* MetricsFileReader::int32_column(int column, int chunk) const {
+    if (columns[column].type != MetricsColumnType::INT32) {
+        throw std::invalid_argument("Column " + columns[column].name + " is not int32");
+    }
+    return reinterpret_cast<const int32_t*>(chunk_columns[chunk][column]);
+}
+
+double MetricsFileReader::value(int column, long row) const {
+    int chunk = std::upper_bound(chunk_first_rows.begin(), chunk_first_rows.end(), row) - 
+                chunk_first_rows.begin() - 1;
+    long offset = row - chunk_first_rows[chunk];
+    if (columns[column].type == MetricsColumnType::INT32) {
+        return int32_column(column, chunk)[offset];
+    }
+    return float64_column(column, chunk)[offset];
+}
+
+std::vector<double> MetricsFileReader::read_column(int column) const {
+    std::vector<double> values;
+    values.reserve(total_rows);
+    for (int chunk = 0; chunk < num_chunks(); chunk++) {
+        if (columns[column].type == MetricsColumnType::INT32) {
+            const int32_t* in = int32_column(column, chunk);
+            values.insert(values.end(), in, in + chunk_rows[chunk]);
+        } else {
+            const double* in = float64_column(column, chunk);
+            values.insert(values.end(), in, in + chunk_rows[chunk]);
+        }
+    }
+    return values;
+}
+
+void MetricsFileReader::write_csv(const std::string& csv_path) const {
+    std::ofstream out(csv_path);
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not open file for writing: " + csv_path);
+    }
+    
+    for (size_t c = 0; c < columns.size(); c++) {
+        out << (c > 0 ? "," : "") << columns[c].name;
+    }
+    out << "\n";
+    
+    for (int chunk = 0; chunk < num_chunks(); chunk++) {
+        for (long r = 0; r < chunk_rows[chunk]; r++) {
+            for (size_t c = 0; c < columns.size(); c++) {
+                if (c > 0) out << ",";
+                if (columns[c].type == MetricsColumnType::INT32) {
+                    out << int32_column(c, chunk)[r];
+                } else {
+                    out << float64_column(c, chunk)[r];
+                }
+            }
+            out << "\n";
+        }
+    }
+    
+    if (training_time >= 0.0) {
+        out << "training_time_seconds," << training_time << "\n";
+    }
+}
+
 // SingleAgentTrainer Implementation
 
-SingleAgentTrainer::SingleAgentTrainer(const TrainingConfig& config) : config(config) {
+SingleAgentTrainer::SingleAgentTrainer(const TrainingConfig& config)
+    : config(config), metrics(config.rolling_window) {
     // Create environment
     env = std::make_unique<MinorityGameEnv>(
         config.num_players, config.memory_size, config.num_strategies,
         config.equilibration_time, config.max_episode_steps, 0, config.seed
     );
+    env->set_reset_policy(config.reset_policy);
     
     // Create agent
     agent = create_agent(config.agent_type, env->get_observation_space_size(),
@@ -131,8 +747,12 @@ SingleAgentTrainer::SingleAgentTrainer(const TrainingConfig& config) : config(co
 }
 
 void SingleAgentTrainer::create_directories() {
-    TrainingUtils::ensure_directory_exists(config.model_save_path);
-    TrainingUtils::ensure_directory_exists(config.metrics_save_path);
+    if (config.save_model) {
+        TrainingUtils::ensure_directory_exists(config.model_save_path);
+    }
+    if (config.save_metrics) {
+        TrainingUtils::ensure_directory_exists(config.metrics_save_path);
+    }
 }
 
 std::string SingleAgentTrainer::generate_model_filename() const {
@@ -142,67 +762,84 @@ std::string SingleAgentTrainer::generate_model_filename() const {
 
 std::string SingleAgentTrainer::generate_metrics_filename() const {
     return config.metrics_save_path + config.agent_type + "_metrics_" + 
-           TrainingUtils::get_timestamp_string() + ".csv";
+           TrainingUtils::get_timestamp_string() + 
+           TrainingUtils::metrics_extension(config.metrics_format);
+}
+
+void SingleAgentTrainer::record_episode(double reward, double win_rate, int length) {
+    metrics.add_episode(reward, win_rate, length);
+    if (metrics_writer) {
+        metrics_writer->add_row({reward, win_rate, metrics.average_rewards.back(), (double)length});
+    }
 }
 
 TrainingMetrics SingleAgentTrainer::train() {
-    std::cout << "Starting single agent training..." << std::endl;
-    std::cout << "Agent: " << config.agent_type << std::endl;
-    std::cout << "Episodes: " << config.episodes << std::endl;
-    std::cout << "Environment: " << config.num_players << " players, " 
-              << config.memory_size << " memory" << std::endl;
+    if (config.verbose) {
+        std::cout << "Starting single agent training..." << std::endl;
+        std::cout << "Agent: " << config.agent_type << std::endl;
+        std::cout << "Episodes: " << config.episodes << std::endl;
+        std::cout << "Environment: " << config.num_players << " players, " 
+                  << config.memory_size << " memory" << std::endl;
+    }
+    
+    if (config.save_metrics && config.metrics_flush_interval > 0) {
+        metrics_writer = std::make_unique<MetricsStreamWriter>(
+            generate_metrics_filename(), TrainingMetrics::columns(),
+            config.metrics_flush_interval, false, config.metrics_format);
+    }
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    for (int episode = 0; episode < config.episodes; episode++) {
-        Observation obs = env->reset();
-        double total_reward = 0.0;
-        
-        EnvInfo final_info;
-        
-        for (int step = 0; step < config.max_episode_steps; step++) {
-            // Select action
-            int action = agent->predict(obs);
+    if (config.actor_learner) {
+        train_actor_learner();
+    } else if (config.num_threads > 1) {
+        train_parallel();
+    } else {
+        for (int episode = 0; episode < config.episodes; episode++) {
+            Observation obs = env->reset();
+            double total_reward = 0.0;
             
-            // Take step
-            auto [next_obs, reward, terminated, info] = env->step(action);
+            EnvInfo final_info;
+            
+            for (int step = 0; step < config.max_episode_steps; step++) {
+                // Select action
+                int action = agent->predict(obs);
+                
+                // Take step
+                auto [next_obs, reward, terminated, info] = env->step(action);
+                
+                // Learn
+                agent->learn(obs, action, reward, next_obs, terminated);
+                agent->advance_exploration(ScheduleUnit::STEP);
+                
+                obs = next_obs;
+                total_reward += reward;
+                
+                if (terminated) {
+                    final_info = info;
+                    break;
+                }
+            }
             
-            // Learn
-            agent->learn(obs, action, reward, next_obs, terminated);
+            // Record metrics
+            record_episode(total_reward, final_info.win_rate, final_info.step);
             
-            obs = next_obs;
-            total_reward += reward;
+            // Decay epsilon for exploration
+            agent->advance_exploration(ScheduleUnit::EPISODE);
             
-            if (terminated) {
-                final_info = info;
-                break;
+            // Render occasionally
+            if (config.verbose && episode % config.render_frequency == 0) {
+                std::cout << "Episode " << episode << ": Reward = " << std::fixed 
+                          << std::setprecision(2) << total_reward 
+                          << ", Win Rate = " << std::setprecision(1) 
+                          << final_info.win_rate * 100 << "%" << std::endl;
             }
-        }
-        
-        // Record metrics
-        metrics.add_episode(total_reward, final_info.win_rate, final_info.step);
-        
-        // Decay epsilon for exploration
-        if (config.agent_type == "qlearning" || config.agent_type == "dqn") {
-            if (auto* q_agent = dynamic_cast<QLearningAgent*>(agent.get())) {
-                q_agent->decay_epsilon();
-            } else if (auto* dqn_agent = dynamic_cast<DQNAgent*>(agent.get())) {
-                dqn_agent->decay_epsilon();
+            
+            // Save model periodically
+            if (config.save_model && episode % config.save_frequency == 0 && episode > 0) {
+                save_model();
             }
         }
-        
-        // Render occasionally
-        if (config.verbose && episode % config.render_frequency == 0) {
-            std::cout << "Episode " << episode << ": Reward = " << std::fixed 
-                      << std::setprecision(2) << total_reward 
-                      << ", Win Rate = " << std::setprecision(1) 
-                      << final_info.win_rate * 100 << "%" << std::endl;
-        }
-        
-        // Save model periodically
-        if (config.save_model && episode % config.save_frequency == 0 && episode > 0) {
-            save_model();
-        }
     }
     
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -212,42 +849,429 @@ TrainingMetrics SingleAgentTrainer::train() {
     if (config.save_model) {
         save_model();
     }
-    save_metrics();
+    if (metrics_writer) {
+        metrics_writer->close(metrics.training_time.count());
+        std::cout << "Training metrics streamed to " << metrics_writer->get_filepath() << std::endl;
+        metrics_writer.reset();
+    } else if (config.save_metrics) {
+        save_metrics();
+    }
     
-    std::cout << "Training completed!" << std::endl;
-    metrics.print_summary();
+    if (config.verbose) {
+        std::cout << "Training completed!" << std::endl;
+        metrics.print_summary();
+    }
     
     return metrics;
 }
 
-void SingleAgentTrainer::evaluate(int num_episodes) {
-    std::cout << "Evaluating agent for " << num_episodes << " episodes..." << std::endl;
+std::unique_ptr<MinorityGameEnv> SingleAgentTrainer::make_actor_env(unsigned int seed) const {
+    // Constructing the environment seeds the calling thread's RND stream
+    auto actor_env = std::make_unique<MinorityGameEnv>(
+        config.num_players, config.memory_size, config.num_strategies,
+        config.equilibration_time, config.max_episode_steps, 0, (long)(seed & 0x7fffffff)
+    );
+    actor_env->set_reset_policy(config.reset_policy);
+    return actor_env;
+}
+
+unsigned int SingleAgentTrainer::actor_base_seed() const {
+    return (config.seed >= 0) ? (unsigned int)config.seed : std::random_device{}();
+}
+
+// Counters of one actor thread of train_parallel or train_actor_learner
+struct ActorEpisodes {
+    long steps = 0;
+    long dropped = 0;
+    long exploration_ticks = 0;  // Ticks of the actor's own exploration schedule
+};
+
+struct FinishedEpisode {
+    double reward;
+    double win_rate;
+    int length;
+};
+
+// Episodes handed from the actor threads to the trainer's thread while training runs
+class EpisodeOutbox {
+public:
+    explicit EpisodeOutbox(int producers) : open_producers(producers) {}
+    
+    void push(const FinishedEpisode& episode) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(episode);
+        }
+        ready.notify_one();
+    }
+    
+    // Called by each actor once it has pushed its last episode
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            open_producers--;
+        }
+        ready.notify_one();
+    }
+    
+    // Moves the pending episodes into out without blocking
+    void drain(std::vector<FinishedEpisode>& out) {
+        out.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        out.swap(pending);
+    }
+    
+    // Blocks until episodes are pending; false once every actor finished and none are left
+    bool wait_drain(std::vector<FinishedEpisode>& out) {
+        out.clear();
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this]() { return !pending.empty() || open_producers == 0; });
+        out.swap(pending);
+        return !out.empty();
+    }
+    
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::vector<FinishedEpisode> pending;
+    int open_producers;
+};
+
+void SingleAgentTrainer::train_parallel() {
+    auto* q_agent = dynamic_cast<QLearningAgent*>(agent.get());
+    if (!q_agent) {
+        throw std::invalid_argument("Parallel training supports the qlearning agent only");
+    }
     
-    std::vector<double> eval_rewards;
-    std::vector<double> eval_win_rates;
+    int num_threads = config.num_threads;
+    SharedQTable table(env->get_observation_space_size(), env->get_action_space_size(),
+                       config.shared_update_mode);
+    table.copy_from(q_agent->get_q_table());
+    
+    double learning_rate = q_agent->get_learning_rate();
+    double gamma = q_agent->get_gamma();
+    
+    // Every actor runs the agent's exploration schedule from where it is now
+    ExplorationSchedule schedule = agent->get_exploration_schedule();
+    long start_ticks = agent->get_exploration_ticks();
+    
+    // Every actor gets its own environment and exploration seed
+    unsigned int base_seed = actor_base_seed();
+    
+    if (config.verbose) {
+        std::cout << "Actors: " << num_threads << " threads ("
+                  << (config.shared_update_mode == SharedUpdateMode::HOGWILD ? "hogwild" : "striped locks")
+                  << " updates)" << std::endl;
+    }
+    auto start_time = std::chrono::high_resolution_clock::now();
     
-    for (int episode = 0; episode < num_episodes; episode++) {
-        Observation obs = env->reset();
-        double total_reward = 0.0;
+    std::vector<ActorEpisodes> results(num_threads);
+    EpisodeOutbox outbox(num_threads);
+    std::vector<std::thread> actors;
+    for (int t = 0; t < num_threads; t++) {
+        int episodes = config.episodes / num_threads + (t < config.episodes % num_threads ? 1 : 0);
         
-        EnvInfo final_info;
+        actors.emplace_back([&, t, episodes]() {
+            ActorEpisodes& out = results[t];
+            unsigned int seed = base_seed + 1 + t;
+            
+            std::unique_ptr<MinorityGameEnv> actor_env = make_actor_env(seed);
+            
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<double> explore_dist(0.0, 1.0);
+            std::uniform_int_distribution<int> action_dist(0, actor_env->get_action_space_size() - 1);
+            double epsilon = schedule.value(start_ticks);
+            bool per_step = (schedule.unit == ScheduleUnit::STEP);
+            
+            for (int episode = 0; episode < episodes; episode++) {
+                Observation obs = actor_env->reset();
+                double total_reward = 0.0;
+                EnvInfo final_info;
+                
+                for (int step = 0; step < config.max_episode_steps; step++) {
+                    // Epsilon-greedy on the shared table
+                    int action = (explore_dist(rng) < epsilon) ? action_dist(rng) :
+                                 table.greedy_action(obs.mu);
+                    
+                    auto [next_obs, reward, terminated, info] = actor_env->step(action);
+                    
+                    // Q-learning update
+                    double next_max_q = terminated ? 0.0 : table.max_value(next_obs.mu);
+                    table.update(obs.mu, action, learning_rate, reward + gamma * next_max_q);
+                    
+                    obs = next_obs;
+                    total_reward += reward;
+                    out.steps++;
+                    if (per_step) {
+                        epsilon = schedule.value(start_ticks + ++out.exploration_ticks);
+                    }
+                    
+                    if (terminated) {
+                        final_info = info;
+                        break;
+                    }
+                }
+                
+                outbox.push({total_reward, final_info.win_rate, final_info.step});
+                if (!per_step) {
+                    epsilon = schedule.value(start_ticks + ++out.exploration_ticks);
+                }
+            }
+            outbox.finish();
+        });
+    }
+    
+    // Record episodes in completion order while the actors run
+    std::vector<FinishedEpisode> finished;
+    while (outbox.wait_drain(finished)) {
+        for (const FinishedEpisode& episode : finished) {
+            record_episode(episode.reward, episode.win_rate, episode.length);
+        }
+    }
+    
+    for (std::thread& actor : actors) {
+        actor.join();
+    }
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end_time - start_time;
+    
+    long total_steps = 0;
+    for (const ActorEpisodes& actor : results) {
+        total_steps += actor.steps;
+    }
+    
+    // Hand the learned values back to the trainer's agent
+    table.copy_to(q_agent->get_q_table());
+    agent->advance_exploration(schedule.unit, results[0].exploration_ticks);
+    
+    if (config.verbose) {
+        std::cout << "Environment steps: " << total_steps << " (" << std::fixed << std::setprecision(0)
+                  << total_steps / std::max(elapsed.count(), 1e-9) << " steps/s)" << std::endl;
+    }
+}
+
+// Transition sent from an actor to the learner
+struct ActorTransition {
+    Observation obs;
+    Observation next_obs;
+    double reward;
+    int action;
+    bool done;
+    long policy_version;  // Snapshot the action was chosen with
+};
+
+// Greedy action of every memory state, published by the learner
+struct PolicySnapshot {
+    long version;
+    std::vector<uint8_t> actions;
+};
+
+void SingleAgentTrainer::train_actor_learner() {
+    int num_actors = std::max(1, config.num_threads);
+    int memory_size = env->get_observation_space_size();
+    if (memory_size > QTable::DENSE_MAX_BITS) {
+        throw std::invalid_argument("Actor-learner training supports memory sizes up to " +
+                                    std::to_string(QTable::DENSE_MAX_BITS));
+    }
+    
+    // Every actor runs the agent's exploration schedule from where it is now
+    ExplorationSchedule schedule = agent->get_exploration_schedule();
+    long start_ticks = agent->get_exploration_ticks();
+    
+    // Policy snapshots: the learner evaluates every memory state at once
+    unsigned long num_states = 1UL << memory_size;
+    std::vector<Observation> all_states;
+    for (unsigned long mu = 0; mu < num_states; mu++) {
+        all_states.push_back(Observation(memory_size, mu));
+    }
+    std::vector<int> greedy(num_states);
+    
+    std::mutex snapshot_mutex;
+    std::shared_ptr<const PolicySnapshot> published;
+    std::atomic<long> published_version(0);
+    
+    auto publish = [&](long version) {
+        // Reading the greedy actions must not create entries for unvisited states
+        if (agent->has_deterministic_policy()) {
+            agent->greedy_actions(all_states.data(), num_states, greedy.data());
+        } else {
+            agent->predict_batch(all_states.data(), num_states, greedy.data(), true);
+        }
+        auto snapshot = std::make_shared<PolicySnapshot>();
+        snapshot->version = version;
+        snapshot->actions.assign(greedy.begin(), greedy.end());
+        {
+            std::lock_guard<std::mutex> guard(snapshot_mutex);
+            published = snapshot;
+        }
+        published_version.store(version, std::memory_order_release);
+    };
+    publish(0);
+    
+    MPSCQueue<ActorTransition> queue(config.queue_capacity);
+    int sync_interval = std::max(1, config.policy_sync_interval);
+    std::atomic<int> finished_actors(0);
+    unsigned int base_seed = actor_base_seed();
+    
+    if (config.verbose) {
+        std::cout << "Actors: " << num_actors << " threads, queue capacity " << queue.get_capacity()
+                  << ", policy sync every " << sync_interval << " transitions" << std::endl;
+    }
+    
+    std::vector<ActorEpisodes> results(num_actors);
+    EpisodeOutbox outbox(num_actors);
+    std::vector<std::thread> actors;
+    for (int t = 0; t < num_actors; t++) {
+        int episodes = config.episodes / num_actors + (t < config.episodes % num_actors ? 1 : 0);
         
-        for (int step = 0; step < config.max_episode_steps; step++) {
-            int action = agent->predict(obs, true); // Deterministic
-            auto [next_obs, reward, terminated, info] = env->step(action);
+        actors.emplace_back([&, t, episodes]() {
+            ActorEpisodes& out = results[t];
+            unsigned int seed = base_seed + 1 + t;
+            std::unique_ptr<MinorityGameEnv> actor_env = make_actor_env(seed);
             
-            obs = next_obs;
-            total_reward += reward;
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<double> explore_dist(0.0, 1.0);
+            std::uniform_int_distribution<int> action_dist(0, actor_env->get_action_space_size() - 1);
+            double epsilon = schedule.value(start_ticks);
+            bool per_step = (schedule.unit == ScheduleUnit::STEP);
             
-            if (terminated) {
-                final_info = info;
-                break;
+            std::shared_ptr<const PolicySnapshot> policy;
+            {
+                std::lock_guard<std::mutex> guard(snapshot_mutex);
+                policy = published;
+            }
+            
+            for (int episode = 0; episode < episodes; episode++) {
+                Observation obs = actor_env->reset();
+                double total_reward = 0.0;
+                EnvInfo final_info;
+                
+                for (int step = 0; step < config.max_episode_steps; step++) {
+                    // Pick up a newer snapshot; the lock is only taken when one exists
+                    if (published_version.load(std::memory_order_acquire) != policy->version) {
+                        std::lock_guard<std::mutex> guard(snapshot_mutex);
+                        policy = published;
+                    }
+                    
+                    int action = (explore_dist(rng) < epsilon) ? action_dist(rng) :
+                                 policy->actions[obs.mu];
+                    
+                    auto [next_obs, reward, terminated, info] = actor_env->step(action);
+                    
+                    ActorTransition transition{obs, next_obs, reward, action, terminated, policy->version};
+                    if (queue.try_push(transition)) {
+                        out.steps++;
+                    } else {
+                        out.dropped++;
+                    }
+                    
+                    obs = next_obs;
+                    total_reward += reward;
+                    if (per_step) {
+                        epsilon = schedule.value(start_ticks + ++out.exploration_ticks);
+                    }
+                    
+                    if (terminated) {
+                        final_info = info;
+                        break;
+                    }
+                }
+                
+                outbox.push({total_reward, final_info.win_rate, final_info.step});
+                if (!per_step) {
+                    epsilon = schedule.value(start_ticks + ++out.exploration_ticks);
+                }
             }
+            
+            outbox.finish();
+            finished_actors.fetch_add(1, std::memory_order_release);
+        });
+    }
+    
+    // Learner: this thread owns the agent and drains the queue
+    ActorLearnerStats stats;
+    long version = 0;
+    long depth_samples = 0;
+    double depth_sum = 0.0;
+    double lag_sum = 0.0;
+    ActorTransition transition;
+    std::vector<FinishedEpisode> finished;
+    
+    for (;;) {
+        // Read before draining, so a finished run leaves nothing behind
+        bool actors_done = finished_actors.load(std::memory_order_acquire) == num_actors;
+        
+        long drained = 0;
+        while (queue.try_pop(transition)) {
+            size_t depth = queue.size_approx() + 1;
+            stats.max_queue_depth = std::max(stats.max_queue_depth, depth);
+            depth_sum += depth;
+            depth_samples++;
+            
+            agent->learn(transition.obs, transition.action, transition.reward,
+                         transition.next_obs, transition.done);
+            drained++;
+            stats.transitions_learned++;
+            
+            long lag = version - transition.policy_version;
+            lag_sum += lag;
+            stats.max_policy_lag = std::max(stats.max_policy_lag, lag);
+            
+            if (stats.transitions_learned % sync_interval == 0) {
+                publish(++version);
+            }
+        }
+        
+        // Record the episodes the actors completed so far
+        outbox.drain(finished);
+        for (const FinishedEpisode& episode : finished) {
+            record_episode(episode.reward, episode.win_rate, episode.length);
         }
         
-        eval_rewards.push_back(total_reward);
-        eval_win_rates.push_back(final_info.win_rate);
+        if (actors_done && drained == 0) break;
+        if (drained == 0) std::this_thread::yield();
+    }
+    
+    for (std::thread& actor : actors) {
+        actor.join();
     }
+    agent->advance_exploration(schedule.unit, results[0].exploration_ticks);
+    
+    for (const ActorEpisodes& actor : results) {
+        stats.transitions_pushed += actor.steps;
+        stats.transitions_dropped += actor.dropped;
+    }
+    
+    stats.mean_queue_depth = depth_sum / std::max(1L, depth_samples);
+    stats.policy_versions = version + 1;
+    stats.mean_policy_lag = lag_sum / std::max(1L, stats.transitions_learned);
+    actor_learner_stats = stats;
+    if (config.verbose) {
+        stats.print();
+    }
+}
+
+void ActorLearnerStats::print() const {
+    std::cout << "\n=== Actor-Learner Statistics ===" << std::endl;
+    std::cout << "Transitions pushed: " << transitions_pushed << std::endl;
+    std::cout << "Transitions dropped: " << transitions_dropped << std::endl;
+    std::cout << "Transitions learned: " << transitions_learned << std::endl;
+    std::cout << "Queue depth: mean " << std::fixed << std::setprecision(1) << mean_queue_depth
+              << ", max " << max_queue_depth << std::endl;
+    std::cout << "Policy snapshots: " << policy_versions << std::endl;
+    std::cout << "Policy lag: mean " << std::fixed << std::setprecision(2) << mean_policy_lag
+              << ", max " << max_policy_lag << std::endl;
+    std::cout << "================================" << std::endl;
+}
+
+void SingleAgentTrainer::evaluate(int num_episodes) {
+    std::cout << "Evaluating agent for " << num_episodes << " episodes..." << std::endl;
+    
+    EvaluationResult result = TrainingUtils::evaluate_policy(*agent, config, num_episodes,
+                                                             config.eval_threads);
+    const std::vector<double>& eval_rewards = result.rewards;
+    const std::vector<double>& eval_win_rates = result.win_rates;
     
     double avg_reward = TrainingUtils::calculate_mean(eval_rewards);
     double std_reward = TrainingUtils::calculate_std(eval_rewards);
@@ -290,25 +1314,47 @@ void MultiAgentTrainingMetrics::add_episode(const std::vector<double>& rewards,
         episode_rewards[i].push_back(rewards[i]);
         win_rates[i].push_back(win_rates_vec[i]);
         
-        // Calculate running average reward
-        if (episode_rewards[i].size() >= 100) {
-            double sum = 0.0;
-            for (int j = episode_rewards[i].size() - 100; j < (int)episode_rewards[i].size(); j++) {
-                sum += episode_rewards[i][j];
-            }
-            average_rewards[i].push_back(sum / 100.0);
-        } else {
-            double sum = 0.0;
-            for (double r : episode_rewards[i]) {
-                sum += r;
-            }
-            average_rewards[i].push_back(sum / episode_rewards[i].size());
-        }
+        reward_stats[i].add(rewards[i]);
+        win_rate_stats[i].add(win_rates_vec[i]);
+        average_rewards[i].push_back(reward_stats[i].mean());
     }
     episode_lengths.push_back(length);
 }
 
+std::vector<MetricsColumn> MultiAgentTrainingMetrics::columns(int num_agents) {
+    std::vector<MetricsColumn> result;
+    for (int i = 0; i < num_agents; i++) {
+        std::string agent = "agent" + std::to_string(i);
+        result.emplace_back(agent + "_reward");
+        result.emplace_back(agent + "_win_rate");
+        result.emplace_back(agent + "_avg_reward");
+    }
+    result.emplace_back("episode_length", MetricsColumnType::INT32);
+    return result;
+}
+
 void MultiAgentTrainingMetrics::save_to_file(const std::string& filepath) const {
+    if (TrainingUtils::metrics_format_for_path(filepath) == MetricsFormat::BINARY) {
+        size_t num_agents = episode_rewards.size();
+        size_t max_episodes = episode_rewards.empty() ? 0 : episode_rewards[0].size();
+        MetricsStreamWriter writer(filepath, columns(num_agents), std::max<size_t>(1, max_episodes),
+                                   false, MetricsFormat::BINARY);
+        std::vector<double> row;
+        for (size_t ep = 0; ep < max_episodes; ep++) {
+            row.clear();
+            for (size_t i = 0; i < num_agents; i++) {
+                row.push_back(episode_rewards[i][ep]);
+                row.push_back(win_rates[i][ep]);
+                row.push_back(ep < average_rewards[i].size() ? average_rewards[i][ep] : 0.0);
+            }
+            row.push_back(ep < episode_lengths.size() ? episode_lengths[ep] : 0);
+            writer.add_row(row);
+        }
+        writer.close(training_time.count());
+        std::cout << "Multi-agent training metrics saved to " << filepath << std::endl;
+        return;
+    }
+    
     std::ofstream file(filepath);
     if (file.is_open()) {
         file << "episode";
@@ -328,21 +1374,93 @@ void MultiAgentTrainingMetrics::save_to_file(const std::string& filepath) const
                     file << ",";
                 }
             }
-            if (ep < episode_lengths.size()) {
-                file << "," << episode_lengths[ep];
+            if (ep < episode_lengths.size()) {
+                file << "," << episode_lengths[ep];
+            }
+            file << "\n";
+        }
+        
+        file << "training_time_seconds," << training_time.count() << "\n";
+        file.close();
+        std::cout << "Multi-agent training metrics saved to " << filepath << std::endl;
+    } else {
+        throw std::runtime_error("Could not open file for writing: " + filepath);
+    }
+}
+
+void MultiAgentTrainingMetrics::load_from_file(const std::string& filepath) {
+    size_t num_agents = episode_rewards.size();
+    for (size_t i = 0; i < num_agents; i++) {
+        episode_rewards[i].clear();
+        win_rates[i].clear();
+        average_rewards[i].clear();
+        reward_stats[i].clear();
+        win_rate_stats[i].clear();
+    }
+    episode_lengths.clear();
+    
+    if (MetricsFileReader::is_binary_file(filepath)) {
+        MetricsFileReader reader(filepath);
+        if (reader.num_columns() != (int)columns(num_agents).size() + 1) {
+            throw std::runtime_error("Metrics file does not match " + std::to_string(num_agents) +
+                                     " agents: " + filepath);
+        }
+        for (size_t i = 0; i < num_agents; i++) {
+            episode_rewards[i] = reader.read_column(1 + 3 * i);
+            win_rates[i] = reader.read_column(2 + 3 * i);
+            average_rewards[i] = reader.read_column(3 + 3 * i);
+        }
+        for (double length : reader.read_column(reader.num_columns() - 1)) {
+            episode_lengths.push_back((int)length);
+        }
+        if (reader.get_training_time() >= 0.0) {
+            training_time = std::chrono::duration<double>(reader.get_training_time());
+        }
+    } else {
+        std::ifstream file(filepath);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file for reading: " + filepath);
+        }
+        
+        std::string line;
+        std::getline(file, line); // Skip header
+        while (std::getline(file, line)) {
+            if (line.find("training_time_seconds") != std::string::npos) {
+                size_t comma_pos = line.find(',');
+                if (comma_pos != std::string::npos) {
+                    double seconds = std::stod(line.substr(comma_pos + 1));
+                    training_time = std::chrono::duration<double>(seconds);
+                }
+                break;
+            }
+            
+            std::istringstream iss(line);
+            std::string token;
+            std::vector<std::string> tokens;
+            while (std::getline(iss, token, ',')) {
+                tokens.push_back(token);
+            }
+            if (tokens.size() < 3 * num_agents + 2) continue;
+            
+            for (size_t i = 0; i < num_agents; i++) {
+                episode_rewards[i].push_back(std::stod(tokens[1 + 3 * i]));
+                win_rates[i].push_back(std::stod(tokens[2 + 3 * i]));
+                average_rewards[i].push_back(std::stod(tokens[3 + 3 * i]));
             }
-            file << "\n";
+            episode_lengths.push_back(std::stoi(tokens[3 * num_agents + 1]));
         }
-        
-        file << "training_time_seconds," << training_time.count() << "\n";
-        file.close();
-        std::cout << "Multi-agent training metrics saved to " << filepath << std::endl;
-    } else {
-        throw std::runtime_error("Could not open file for writing: " + filepath);
     }
+    
+    for (size_t i = 0; i < num_agents; i++) {
+        for (size_t ep = 0; ep < episode_rewards[i].size(); ep++) {
+            reward_stats[i].add(episode_rewards[i][ep]);
+            win_rate_stats[i].add(win_rates[i][ep]);
+        }
+    }
+    std::cout << "Multi-agent training metrics loaded from " << filepath << std::endl;
 }
 
-void MultiAgentTrainingMetrics::print_summary() const {
+void MultiAgentTrainingMetrics::print_summary(bool aggregate) const {
     if (episode_rewards.empty() || episode_rewards[0].empty()) {
         std::cout << "No training data available." << std::endl;
         return;
@@ -352,6 +1470,25 @@ void MultiAgentTrainingMetrics::print_summary() const {
     std::cout << "Episodes: " << episode_rewards[0].size() << std::endl;
     std::cout << "Training Time: " << training_time.count() << " seconds" << std::endl;
     
+    if (aggregate) {
+        // Spread of the per-agent averages across the population
+        std::vector<double> agent_rewards, agent_win_rates;
+        for (size_t i = 0; i < episode_rewards.size(); i++) {
+            agent_rewards.push_back(TrainingUtils::calculate_mean(episode_rewards[i]));
+            agent_win_rates.push_back(TrainingUtils::calculate_mean(win_rates[i]));
+        }
+        
+        std::cout << "Agents: " << episode_rewards.size() << " (shared parameters)" << std::endl;
+        std::cout << "  Average Reward: " << std::fixed << std::setprecision(3) 
+                  << TrainingUtils::calculate_mean(agent_rewards) << " ± " 
+                  << TrainingUtils::calculate_std(agent_rewards) << std::endl;
+        std::cout << "  Average Win Rate: " << std::fixed << std::setprecision(1) 
+                  << TrainingUtils::calculate_mean(agent_win_rates) * 100 << "% ± " 
+                  << TrainingUtils::calculate_std(agent_win_rates) * 100 << "%" << std::endl;
+        std::cout << "===================================\n" << std::endl;
+        return;
+    }
+    
     for (size_t i = 0; i < episode_rewards.size(); i++) {
         double avg_reward = TrainingUtils::calculate_mean(episode_rewards[i]);
         double std_reward = TrainingUtils::calculate_std(episode_rewards[i]);
@@ -363,6 +1500,9 @@ void MultiAgentTrainingMetrics::print_summary() const {
                   << avg_reward << " ± " << std_reward << std::endl;
         std::cout << "  Average Win Rate: " << std::fixed << std::setprecision(1) 
                   << avg_win_rate * 100 << "% ± " << std_win_rate * 100 << "%" << std::endl;
+        std::cout << "  Final " << reward_stats[i].size() << "-episode Average: " << std::fixed 
+                  << std::setprecision(3) << reward_stats[i].mean() << " ± " 
+                  << reward_stats[i].std() << std::endl;
     }
     std::cout << "===================================\n" << std::endl;
 }
@@ -370,17 +1510,19 @@ void MultiAgentTrainingMetrics::print_summary() const {
 // MultiAgentTrainer Implementation
 
 MultiAgentTrainer::MultiAgentTrainer(const MultiAgentTrainingConfig& config) 
-    : config(config), metrics(config.num_rl_agents) {
+    : config(config), metrics(config.num_rl_agents, config.rolling_window) {
     
     // Create environment
     env = std::make_unique<MultiAgentMinorityGameEnv>(
         config.num_players, config.num_rl_agents, config.memory_size,
         config.num_strategies, config.equilibration_time, 
-        config.max_episode_steps, config.seed
+        config.max_episode_steps, config.seed, 10, config.random_rl_positions
     );
+    env->set_reset_policy(config.reset_policy);
     
     // Create agents
-    for (int i = 0; i < config.num_rl_agents; i++) {
+    int num_agents = config.share_parameters ? 1 : config.num_rl_agents;
+    for (int i = 0; i < num_agents; i++) {
         std::string agent_type = (i < (int)config.agent_types.size()) ? 
                                 config.agent_types[i] : "qlearning";
         std::map<std::string, double> agent_params = (i < (int)config.agent_params.size()) ?
@@ -401,79 +1543,139 @@ void MultiAgentTrainer::create_directories() {
 std::string MultiAgentTrainer::generate_model_filename(int agent_idx) const {
     std::string agent_type = (agent_idx < (int)config.agent_types.size()) ? 
                             config.agent_types[agent_idx] : "qlearning";
-    return config.model_save_path + "multiagent_" + agent_type + "_agent" + 
-           std::to_string(agent_idx) + "_" + TrainingUtils::get_timestamp_string() + ".model";
+    std::string agent_name = config.share_parameters ? "shared" : "agent" + std::to_string(agent_idx);
+    return config.model_save_path + "multiagent_" + agent_type + "_" + agent_name + 
+           "_" + TrainingUtils::get_timestamp_string() + ".model";
 }
 
 std::string MultiAgentTrainer::generate_metrics_filename() const {
     return config.metrics_save_path + "multiagent_metrics_" + 
-           TrainingUtils::get_timestamp_string() + ".csv";
+           TrainingUtils::get_timestamp_string() + 
+           TrainingUtils::metrics_extension(config.metrics_format);
+}
+
+void MultiAgentTrainer::select_actions(const std::vector<Observation>& observations,
+                                       bool deterministic) {
+    int n = observations.size();
+    step_actions.resize(n);
+    
+    if (config.share_parameters) {
+        agents[0]->predict_batch(observations.data(), n, step_actions.data(), deterministic);
+    } else {
+        for (int i = 0; i < n; i++) {
+            step_actions[i] = agents[i]->predict(observations[i], deterministic);
+        }
+    }
+}
+
+void MultiAgentTrainer::learn_step(const std::vector<Observation>& observations,
+                                   const std::vector<double>& rewards,
+                                   const std::vector<Observation>& next_observations, bool done) {
+    int n = observations.size();
+    
+    if (config.share_parameters) {
+        step_dones.assign(n, done ? 1 : 0);
+        agents[0]->learn_batch(observations.data(), step_actions.data(), rewards.data(),
+                               next_observations.data(), step_dones.data(), n);
+    } else {
+        for (int i = 0; i < n; i++) {
+            agents[i]->learn(observations[i], step_actions[i], rewards[i], 
+                             next_observations[i], done);
+        }
+    }
+}
+
+std::vector<double> MultiAgentTrainer::episode_win_rates(
+    const MultiAgentMinorityGameEnv& episode_env) const {
+    const std::vector<int>& wins = episode_env.get_rl_agent_wins();
+    int steps = episode_env.get_current_step();
+    
+    std::vector<double> win_rates(wins.size(), 0.0);
+    if (steps > 0) {
+        for (size_t i = 0; i < wins.size(); i++) {
+            win_rates[i] = (double)wins[i] / steps;
+        }
+    }
+    return win_rates;
 }
 
 MultiAgentTrainingMetrics MultiAgentTrainer::train() {
     std::cout << "Starting multi-agent training..." << std::endl;
-    std::cout << "Agents: " << config.num_rl_agents << std::endl;
+    std::cout << "Agents: " << config.num_rl_agents
+              << (config.share_parameters ? " (shared parameters)" : "") << std::endl;
     std::cout << "Episodes: " << config.episodes << std::endl;
     
+    if (config.metrics_flush_interval > 0) {
+        metrics_writer = std::make_unique<MetricsStreamWriter>(
+            generate_metrics_filename(), MultiAgentTrainingMetrics::columns(config.num_rl_agents),
+            config.metrics_flush_interval, false, config.metrics_format);
+    }
+    
     auto start_time = std::chrono::high_resolution_clock::now();
     
     for (int episode = 0; episode < config.episodes; episode++) {
         std::vector<Observation> observations = env->reset();
         std::vector<double> total_rewards(config.num_rl_agents, 0.0);
         
-        std::vector<EnvInfo> final_infos(config.num_rl_agents);
-        
         for (int step = 0; step < config.max_episode_steps; step++) {
             // Select actions for all agents
-            std::vector<int> actions;
-            for (int i = 0; i < config.num_rl_agents; i++) {
-                actions.push_back(agents[i]->predict(observations[i]));
-            }
+            select_actions(observations, false);
             
             // Take step
-            auto [next_observations, rewards, terminated, info] = env->step(actions);
+            auto [next_observations, rewards, terminated, info] = env->step(step_actions);
             
             // Learn for all agents
+            learn_step(observations, rewards, next_observations, terminated);
+            for (auto& agent : agents) {
+                agent->advance_exploration(ScheduleUnit::STEP);
+            }
             for (int i = 0; i < config.num_rl_agents; i++) {
-                agents[i]->learn(observations[i], actions[i], rewards[i], 
-                               next_observations[i], terminated);
                 total_rewards[i] += rewards[i];
             }
             
-            observations = next_observations;
+            observations = std::move(next_observations);
             
             if (terminated) {
-                final_infos.push_back(info);
                 break;
             }
         }
         
-        // Get win rates from environment (assuming they're stored in info somehow)
-        std::vector<double> win_rates(config.num_rl_agents);
-        for (int i = 0; i < config.num_rl_agents; i++) {
-            win_rates[i] = final_infos[i].win_rate;
-        }
+        // Per-agent win rates of the episode
+        std::vector<double> win_rates = episode_win_rates(*env);
         
         // Record metrics
         metrics.add_episode(total_rewards, win_rates, env->get_current_step());
+        if (metrics_writer) {
+            std::vector<double> row;
+            for (int i = 0; i < config.num_rl_agents; i++) {
+                row.push_back(total_rewards[i]);
+                row.push_back(win_rates[i]);
+                row.push_back(metrics.average_rewards[i].back());
+            }
+            row.push_back(env->get_current_step());
+            metrics_writer->add_row(row);
+        }
         
         // Decay epsilon for exploration
-        for (int i = 0; i < config.num_rl_agents; i++) {
-            if (auto* q_agent = dynamic_cast<QLearningAgent*>(agents[i].get())) {
-                q_agent->decay_epsilon();
-            } else if (auto* dqn_agent = dynamic_cast<DQNAgent*>(agents[i].get())) {
-                dqn_agent->decay_epsilon();
-            }
+        for (auto& agent : agents) {
+            agent->advance_exploration(ScheduleUnit::EPISODE);
         }
         
         // Render occasionally
         if (config.verbose && episode % config.render_frequency == 0) {
             std::cout << "Episode " << episode << ":" << std::endl;
-            for (int i = 0; i < config.num_rl_agents; i++) {
-                std::cout << "  Agent " << i << ": Reward = " << std::fixed 
-                          << std::setprecision(2) << total_rewards[i] 
-                          << ", Win Rate = " << std::setprecision(1) 
-                          << final_infos[i].win_rate * 100 << "%" << std::endl;
+            if (config.share_parameters) {
+                std::cout << "  Population: Mean Reward = " << std::fixed 
+                          << std::setprecision(2) << TrainingUtils::calculate_mean(total_rewards) 
+                          << ", Mean Win Rate = " << std::setprecision(1) 
+                          << TrainingUtils::calculate_mean(win_rates) * 100 << "%" << std::endl;
+            } else {
+                for (int i = 0; i < config.num_rl_agents; i++) {
+                    std::cout << "  Agent " << i << ": Reward = " << std::fixed 
+                              << std::setprecision(2) << total_rewards[i] 
+                              << ", Win Rate = " << std::setprecision(1) 
+                              << win_rates[i] * 100 << "%" << std::endl;
+                }
             }
         }
         
@@ -490,18 +1692,25 @@ MultiAgentTrainingMetrics MultiAgentTrainer::train() {
     if (config.save_models) {
         save_models();
     }
-    save_metrics();
+    if (metrics_writer) {
+        metrics_writer->close(metrics.training_time.count());
+        std::cout << "Multi-agent training metrics streamed to " << metrics_writer->get_filepath() 
+                  << std::endl;
+        metrics_writer.reset();
+    } else {
+        save_metrics();
+    }
     
     std::cout << "Multi-agent training completed!" << std::endl;
-    metrics.print_summary();
+    metrics.print_summary(config.share_parameters);
     
     return metrics;
 }
 
 void MultiAgentTrainer::save_models(const std::string& base_path) {
-    for (int i = 0; i < config.num_rl_agents; i++) {
+    for (size_t i = 0; i < agents.size(); i++) {
         std::string path = base_path.empty() ? generate_model_filename(i) : 
-                          base_path + "_agent" + std::to_string(i) + ".model";
+                          base_path + (config.share_parameters ? "_shared" : "_agent" + std::to_string(i)) + ".model";
         agents[i]->save_model(path);
     }
 }
@@ -513,6 +1722,44 @@ void MultiAgentTrainer::save_metrics(const std::string& filepath) {
 
 // TrainingUtils Implementation
 
+// P(T <= x) for x >= 0 under Student's t with df degrees of freedom, by
+// Simpson integration of the density
+static double student_t_cdf(double x, int df) {
+    const int intervals = 2000;
+    double v = df;
+    double log_norm = std::lgamma((v + 1.0) / 2.0) - std::lgamma(v / 2.0) -
+                      0.5 * std::log(v * std::acos(-1.0));
+    auto density = [&](double t) {
+        return std::exp(log_norm - (v + 1.0) / 2.0 * std::log1p(t * t / v));
+    };
+    
+    double h = x / intervals;
+    double sum = density(0.0) + density(x);
+    for (int i = 1; i < intervals; i++) {
+        sum += density(i * h) * ((i % 2) ? 4.0 : 2.0);
+    }
+    return 0.5 + sum * h / 3.0;
+}
+
+// Two-sided critical value t with P(|T| <= t) = confidence
+static double student_t_critical_value(double confidence, int df) {
+    double target = 0.5 + confidence / 2.0;
+    double lo = 0.0;
+    double hi = 1.0;
+    while (student_t_cdf(hi, df) < target && hi < 1e6) {
+        hi *= 2.0;
+    }
+    for (int iter = 0; iter < 60; iter++) {
+        double mid = 0.5 * (lo + hi);
+        if (student_t_cdf(mid, df) < target) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
 namespace TrainingUtils {
     TrainingConfig create_default_single_config() {
         return TrainingConfig();
@@ -522,6 +1769,36 @@ namespace TrainingUtils {
         return MultiAgentTrainingConfig();
     }
     
+    std::vector<std::map<std::string, double>> create_parameter_grid(
+        const std::map<std::string, std::vector<double>>& param_ranges) {
+        std::vector<std::map<std::string, double>> grid(1);
+        for (const auto& [name, values] : param_ranges) {
+            std::vector<std::map<std::string, double>> expanded;
+            expanded.reserve(grid.size() * values.size());
+            for (const auto& point : grid) {
+                for (double value : values) {
+                    expanded.push_back(point);
+                    expanded.back()[name] = value;
+                }
+            }
+            grid.swap(expanded);
+        }
+        return grid;
+    }
+    
+    std::vector<std::map<std::string, double>> sample_parameters(
+        const std::map<std::string, std::pair<double, double>>& param_ranges,
+        int num_samples, long seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::map<std::string, double>> samples(std::max(0, num_samples));
+        for (auto& sample : samples) {
+            for (const auto& [name, range] : param_ranges) {
+                sample[name] = std::uniform_real_distribution<double>(range.first, range.second)(rng);
+            }
+        }
+        return samples;
+    }
+    
     double calculate_mean(const std::vector<double>& values) {
         if (values.empty()) return 0.0;
         return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
@@ -538,6 +1815,16 @@ namespace TrainingUtils {
         return std::sqrt(sum_sq_diff / (values.size() - 1));
     }
     
+    std::pair<double, double> calculate_confidence_interval(
+        const std::vector<double>& values, double confidence) {
+        double mean = calculate_mean(values);
+        if (values.size() <= 1) return {mean, mean};
+        
+        double t = student_t_critical_value(confidence, values.size() - 1);
+        double half_width = t * calculate_std(values) / std::sqrt((double)values.size());
+        return {mean - half_width, mean + half_width};
+    }
+    
     void ensure_directory_exists(const std::string& path) {
         std::filesystem::create_directories(path);
     }
@@ -546,58 +1833,268 @@ namespace TrainingUtils {
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
         std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
+        // std::localtime shares one static buffer between threads
+        std::tm local_time{};
+#ifdef _WIN32
+        localtime_s(&local_time, &time_t);
+#else
+        localtime_r(&time_t, &local_time);
+#endif
+        ss << std::put_time(&local_time, "%Y%m%d_%H%M%S");
         return ss.str();
     }
+    
+    ResetPolicy parse_reset_policy(const std::string& name) {
+        if (name == "full") return ResetPolicy::FULL;
+        if (name == "keep") return ResetPolicy::KEEP_AGENTS;
+        if (name == "continue") return ResetPolicy::CONTINUE;
+        throw std::invalid_argument("Unknown reset policy: " + name);
+    }
+    
+    SharedUpdateMode parse_shared_update_mode(const std::string& name) {
+        if (name == "hogwild") return SharedUpdateMode::HOGWILD;
+        if (name == "striped") return SharedUpdateMode::STRIPED_LOCKS;
+        throw std::invalid_argument("Unknown shared update mode: " + name);
+    }
+    
+    ScheduleType parse_schedule_type(const std::string& name) {
+        if (name == "exponential") return ScheduleType::EXPONENTIAL;
+        if (name == "linear") return ScheduleType::LINEAR;
+        if (name == "step") return ScheduleType::STEP;
+        throw std::invalid_argument("Unknown exploration schedule: " + name);
+    }
+    
+    MetricsFormat parse_metrics_format(const std::string& name) {
+        if (name == "csv") return MetricsFormat::CSV;
+        if (name == "binary") return MetricsFormat::BINARY;
+        throw std::invalid_argument("Unknown metrics format: " + name);
+    }
+    
+    MetricsFormat metrics_format_for_path(const std::string& path) {
+        return std::filesystem::path(path).extension() == ".bin" ? MetricsFormat::BINARY 
+                                                                 : MetricsFormat::CSV;
+    }
+    
+    std::string metrics_extension(MetricsFormat format) {
+        return format == MetricsFormat::BINARY ? ".bin" : ".csv";
+    }
+    
+    long evaluation_episode_seed(long base_seed, int episode) {
+        // SplitMix64 finalizer, so nearby base seeds do not share episodes
+        uint64_t z = (uint64_t)base_seed * 0x9E3779B97F4A7C15ULL + (uint64_t)episode + 1;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return (long)(z & 0x7fffffff);
+    }
+    
+    std::vector<uint8_t> greedy_policy_table(const RLAgent& agent, int memory_size) {
+        unsigned long num_states = 1UL << memory_size;
+        std::vector<Observation> all_states;
+        for (unsigned long mu = 0; mu < num_states; mu++) {
+            all_states.push_back(Observation(memory_size, mu));
+        }
+        std::vector<int> greedy(num_states);
+        agent.greedy_actions(all_states.data(), num_states, greedy.data());
+        return std::vector<uint8_t>(greedy.begin(), greedy.end());
+    }
+    
+    EvaluationResult evaluate_policy(RLAgent& agent, const TrainingConfig& env_config,
+                                     int num_episodes, int num_threads) {
+        EvaluationResult result;
+        result.rewards.assign(num_episodes, 0.0);
+        result.win_rates.assign(num_episodes, 0.0);
+        result.non_rl_avg_win_rates.assign(num_episodes, 0.0);
+        result.non_rl_std_win_rates.assign(num_episodes, 0.0);
+        
+        int memory_size = env_config.memory_size;
+        bool deterministic = agent.has_deterministic_policy();
+        bool use_table = deterministic && memory_size <= QTable::DENSE_MAX_BITS;
+        std::vector<uint8_t> policy_table;
+        if (use_table) {
+            policy_table = greedy_policy_table(agent, memory_size);
+        } else {
+            num_threads = 1;
+        }
+        
+        long base_seed = (env_config.seed >= 0) ? env_config.seed :
+                         (long)(std::random_device{}() & 0x3fffffff);
+        
+        parallel_for(num_episodes, num_threads, [&](int episode) {
+            MinorityGameEnv env(env_config.num_players, memory_size, env_config.num_strategies,
+                                env_config.equilibration_time, env_config.max_episode_steps, 0,
+                                evaluation_episode_seed(base_seed, episode));
+            env.set_reset_policy(env_config.reset_policy);
+            
+            Observation obs = env.reset();
+            double total_reward = 0.0;
+            EnvInfo final_info;
+            
+            for (int step = 0; step < env_config.max_episode_steps; step++) {
+                int action;
+                if (use_table) {
+                    action = policy_table[obs.mu];
+                } else if (deterministic) {
+                    agent.greedy_actions(&obs, 1, &action);
+                } else {
+                    action = agent.predict(obs, true);
+                }
+                auto [next_obs, reward, terminated, info] = env.step(action);
+                
+                obs = next_obs;
+                total_reward += reward;
+                
+                if (terminated) {
+                    final_info = info;
+                    break;
+                }
+            }
+            
+            result.rewards[episode] = total_reward;
+            result.win_rates[episode] = final_info.win_rate;
+            result.non_rl_avg_win_rates[episode] = env.get_non_rl_avg_win_rate();
+            result.non_rl_std_win_rates[episode] = env.get_non_rl_std_win_rate();
+        });
+        
+        return result;
+    }
+    
+    void parallel_for(int num_jobs, int num_threads, const std::function<void(int)>& job) {
+        if (num_threads <= 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        num_threads = std::min(num_threads, num_jobs);
+        
+        std::atomic<int> next_job(0);
+        std::exception_ptr first_error;
+        std::mutex error_mutex;
+        
+        auto worker = [&]() {
+            for (int i = next_job++; i < num_jobs; i = next_job++) {
+                try {
+                    job(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(error_mutex);
+                    if (!first_error) first_error = std::current_exception();
+                }
+            }
+        };
+        
+        if (num_threads <= 1) {
+            worker();
+        } else {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; t++) {
+                threads.emplace_back(worker);
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+        
+        if (first_error) {
+            std::rethrow_exception(first_error);
+        }
+    }
 }
 
 // MultiAgentTrainer::evaluate implementation
 void MultiAgentTrainer::evaluate(int num_episodes) {
     std::cout << "Evaluating multi-agent system for " << num_episodes << " episodes..." << std::endl;
     
-    std::vector<std::vector<double>> eval_rewards(config.num_rl_agents);
-    std::vector<std::vector<double>> eval_win_rates(config.num_rl_agents);
+    int num_rl_agents = config.num_rl_agents;
+    std::vector<std::vector<double>> eval_rewards(num_rl_agents, std::vector<double>(num_episodes));
+    std::vector<std::vector<double>> eval_win_rates(num_rl_agents, std::vector<double>(num_episodes));
     
-    for (int episode = 0; episode < num_episodes; episode++) {
-        std::vector<Observation> observations = env->reset();
-        std::vector<double> total_rewards(config.num_rl_agents, 0.0);
+    // Threads share one greedy action table per agent; otherwise episodes
+    // run on this thread through the agents themselves
+    bool use_tables = config.memory_size <= QTable::DENSE_MAX_BITS;
+    for (const auto& agent : agents) {
+        use_tables = use_tables && agent->has_deterministic_policy();
+    }
+    std::vector<std::vector<uint8_t>> policy_tables;
+    if (use_tables) {
+        for (const auto& agent : agents) {
+            policy_tables.push_back(TrainingUtils::greedy_policy_table(*agent, config.memory_size));
+        }
+    }
+    int num_threads = use_tables ? config.eval_threads : 1;
+    
+    long base_seed = (config.seed >= 0) ? config.seed : (long)(std::random_device{}() & 0x3fffffff);
+    std::atomic<int> completed(0);
+    std::mutex output_mutex;
+    
+    TrainingUtils::parallel_for(num_episodes, num_threads, [&](int episode) {
+        MultiAgentMinorityGameEnv episode_env(
+            config.num_players, num_rl_agents, config.memory_size, config.num_strategies,
+            config.equilibration_time, config.max_episode_steps,
+            TrainingUtils::evaluation_episode_seed(base_seed, episode), 10,
+            config.random_rl_positions);
+        episode_env.set_reset_policy(config.reset_policy);
         
-        std::vector<EnvInfo> final_infos(config.num_rl_agents);
+        std::vector<Observation> observations = episode_env.reset();
+        std::vector<double> total_rewards(num_rl_agents, 0.0);
+        std::vector<int> actions(num_rl_agents);
         
         for (int step = 0; step < config.max_episode_steps; step++) {
             // Select actions deterministically
-            std::vector<int> actions;
-            for (int i = 0; i < config.num_rl_agents; i++) {
-                actions.push_back(agents[i]->predict(observations[i], true));
+            if (use_tables) {
+                for (int i = 0; i < num_rl_agents; i++) {
+                    const std::vector<uint8_t>& table = policy_tables[config.share_parameters ? 0 : i];
+                    actions[i] = table[observations[i].mu];
+                }
+            } else {
+                select_actions(observations, true);
+                actions = step_actions;
             }
             
             // Take step
-            auto [next_observations, rewards, terminated, info] = env->step(actions);
+            auto [next_observations, rewards, terminated, info] = episode_env.step(actions);
             
-            for (int i = 0; i < config.num_rl_agents; i++) {
+            for (int i = 0; i < num_rl_agents; i++) {
                 total_rewards[i] += rewards[i];
             }
             
-            observations = next_observations;
+            observations = std::move(next_observations);
             
             if (terminated) {
-                final_infos.push_back(info);
                 break;
             }
         }
         
-        for (int i = 0; i < config.num_rl_agents; i++) {
-            eval_rewards[i].push_back(total_rewards[i]);
-            eval_win_rates[i].push_back(final_infos[i].win_rate);
+        std::vector<double> win_rates = episode_win_rates(episode_env);
+        for (int i = 0; i < num_rl_agents; i++) {
+            eval_rewards[i][episode] = total_rewards[i];
+            eval_win_rates[i][episode] = win_rates[i];
         }
         
-        if ((episode + 1) % 20 == 0) {
-            std::cout << "Evaluated " << (episode + 1) << "/" << num_episodes 
+        int done = ++completed;
+        if (done % 20 == 0) {
+            std::lock_guard<std::mutex> guard(output_mutex);
+            std::cout << "Evaluated " << done << "/" << num_episodes 
                       << " episodes..." << std::endl;
         }
-    }
+    });
     
     std::cout << "\n=== Multi-Agent Evaluation Results ===" << std::endl;
+    if (config.share_parameters) {
+        std::vector<double> agent_rewards, agent_win_rates;
+        for (int i = 0; i < config.num_rl_agents; i++) {
+            agent_rewards.push_back(TrainingUtils::calculate_mean(eval_rewards[i]));
+            agent_win_rates.push_back(TrainingUtils::calculate_mean(eval_win_rates[i]));
+        }
+        
+        std::cout << "Agents: " << config.num_rl_agents << " (shared parameters)" << std::endl;
+        std::cout << "  Average Reward: " << std::fixed << std::setprecision(3) 
+                  << TrainingUtils::calculate_mean(agent_rewards) << " ± " 
+                  << TrainingUtils::calculate_std(agent_rewards) << std::endl;
+        std::cout << "  Average Win Rate: " << std::fixed << std::setprecision(1) 
+                  << TrainingUtils::calculate_mean(agent_win_rates) * 100 << "% ± " 
+                  << TrainingUtils::calculate_std(agent_win_rates) * 100 << "%" << std::endl;
+        std::cout << "=====================================\n" << std::endl;
+        return;
+    }
+    
     for (int i = 0; i < config.num_rl_agents; i++) {
         double avg_reward = TrainingUtils::calculate_mean(eval_rewards[i]);
         double std_reward = TrainingUtils::calculate_std(eval_rewards[i]);
@@ -619,10 +2116,27 @@ std::vector<ComparisonResult> AgentComparator::compare_agents(
     const std::vector<std::map<std::string, double>>& agent_params,
     int num_episodes) {
     
-    std::vector<ComparisonResult> results;
+    int seeds = std::max(1, num_seeds);
+    int num_jobs = agent_types.size() * seeds;
     
-    for (size_t i = 0; i < agent_types.size(); i++) {
-        std::cout << "Testing agent: " << agent_types[i] << std::endl;
+    // Every run seeds its own streams, so an unseeded comparison draws a base
+    long base_seed = (base_config.seed >= 0) ? base_config.seed :
+                     (long)(std::random_device{}() & 0x3fffffff);
+    
+    // Training metrics of each run, indexed [agent][seed]
+    std::vector<std::vector<TrainingMetrics>> run_metrics(
+        agent_types.size(), std::vector<TrainingMetrics>(seeds));
+    std::mutex output_mutex;
+    
+    TrainingUtils::parallel_for(num_jobs, num_threads, [&](int job) {
+        size_t i = job / seeds;
+        int s = job % seeds;
+        
+        {
+            std::lock_guard<std::mutex> guard(output_mutex);
+            std::cout << "Testing agent: " << agent_types[i] << " (seed " 
+                      << base_seed + s << ")" << std::endl;
+        }
         
         // Create configuration for this agent
         TrainingConfig agent_config = base_config;
@@ -630,16 +2144,47 @@ std::vector<ComparisonResult> AgentComparator::compare_agents(
         agent_config.agent_params = agent_params[i];
         agent_config.episodes = num_episodes;
         agent_config.verbose = false;
+        agent_config.seed = base_seed + s;
+        agent_config.save_model = persist;
+        agent_config.save_metrics = persist;
+        
+        std::string run_dir = "compare_" + agent_types[i] + "_s" + std::to_string(s) + "/";
+        agent_config.model_save_path = base_config.model_save_path + run_dir;
+        agent_config.metrics_save_path = base_config.metrics_save_path + run_dir;
         
         // Train and evaluate
         SingleAgentTrainer trainer(agent_config);
-        TrainingMetrics metrics = trainer.train();
-        
+        run_metrics[i][s] = trainer.train();
+    });
+    
+    std::vector<ComparisonResult> results;
+    
+    for (size_t i = 0; i < agent_types.size(); i++) {
         ComparisonResult result(agent_types[i]);
-        result.average_reward = TrainingUtils::calculate_mean(metrics.episode_rewards);
-        result.std_reward = TrainingUtils::calculate_std(metrics.episode_rewards);
-        result.average_win_rate = TrainingUtils::calculate_mean(metrics.win_rates);
-        result.std_win_rate = TrainingUtils::calculate_std(metrics.win_rates);
+        std::vector<double> all_rewards;
+        std::vector<double> all_win_rates;
+        
+        for (const TrainingMetrics& metrics : run_metrics[i]) {
+            result.seed_rewards.push_back(TrainingUtils::calculate_mean(metrics.episode_rewards));
+            result.seed_win_rates.push_back(TrainingUtils::calculate_mean(metrics.win_rates));
+            all_rewards.insert(all_rewards.end(), metrics.episode_rewards.begin(),
+                               metrics.episode_rewards.end());
+            all_win_rates.insert(all_win_rates.end(), metrics.win_rates.begin(),
+                                 metrics.win_rates.end());
+        }
+        
+        result.average_reward = TrainingUtils::calculate_mean(result.seed_rewards);
+        result.std_reward = TrainingUtils::calculate_std(all_rewards);
+        result.average_win_rate = TrainingUtils::calculate_mean(result.seed_win_rates);
+        result.std_win_rate = TrainingUtils::calculate_std(all_win_rates);
+        
+        if (seeds > 1) {
+            result.reward_ci = TrainingUtils::calculate_confidence_interval(result.seed_rewards);
+            result.win_rate_ci = TrainingUtils::calculate_confidence_interval(result.seed_win_rates);
+        } else {
+            result.reward_ci = TrainingUtils::calculate_confidence_interval(all_rewards);
+            result.win_rate_ci = TrainingUtils::calculate_confidence_interval(all_win_rates);
+        }
         
         results.push_back(result);
     }
@@ -651,17 +2196,30 @@ std::vector<ComparisonResult> AgentComparator::compare_agents(
 void AgentComparator::print_comparison_results(const std::vector<ComparisonResult>& results) {
     std::cout << "\n=== Agent Comparison Results ===" << std::endl;
     std::cout << std::setw(15) << "Agent" 
+              << std::setw(8) << "Seeds"
               << std::setw(15) << "Avg Reward" 
+              << std::setw(12) << "95% CI"
               << std::setw(15) << "Std Reward"
               << std::setw(15) << "Win Rate"
+              << std::setw(12) << "95% CI"
               << std::setw(15) << "Std Win Rate" << std::endl;
-    std::cout << std::string(75, '-') << std::endl;
+    std::cout << std::string(107, '-') << std::endl;
     
     for (const auto& result : results) {
+        std::ostringstream reward_ci;
+        std::ostringstream win_rate_ci;
+        reward_ci << "± " << std::fixed << std::setprecision(3)
+                  << (result.reward_ci.second - result.reward_ci.first) / 2.0;
+        win_rate_ci << "± " << std::fixed << std::setprecision(1)
+                    << (result.win_rate_ci.second - result.win_rate_ci.first) / 2.0 * 100 << "%";
+        
         std::cout << std::setw(15) << result.agent_name
+                  << std::setw(8) << result.seed_rewards.size()
                   << std::setw(15) << std::fixed << std::setprecision(3) << result.average_reward
+                  << std::setw(13) << reward_ci.str()
                   << std::setw(15) << std::fixed << std::setprecision(3) << result.std_reward
                   << std::setw(15) << std::fixed << std::setprecision(1) << result.average_win_rate * 100 << "%"
+                  << std::setw(13) << win_rate_ci.str()
                   << std::setw(15) << std::fixed << std::setprecision(1) << result.std_win_rate * 100 << "%" << std::endl;
     }
     std::cout << "================================\n" << std::endl;
@@ -672,17 +2230,325 @@ void AgentComparator::save_comparison_results(const std::vector<ComparisonResult
                                             const std::string& filepath) {
     std::ofstream file(filepath);
     if (file.is_open()) {
-        file << "agent,avg_reward,std_reward,avg_win_rate,std_win_rate\n";
+        file << "agent,avg_reward,std_reward,avg_win_rate,std_win_rate,"
+             << "num_seeds,reward_ci_low,reward_ci_high,win_rate_ci_low,win_rate_ci_high\n";
         for (const auto& result : results) {
             file << result.agent_name << ","
                  << result.average_reward << ","
                  << result.std_reward << ","
                  << result.average_win_rate << ","
-                 << result.std_win_rate << "\n";
+                 << result.std_win_rate << ","
+                 << result.seed_rewards.size() << ","
+                 << result.reward_ci.first << ","
+                 << result.reward_ci.second << ","
+                 << result.win_rate_ci.first << ","
+                 << result.win_rate_ci.second << "\n";
         }
         file.close();
         std::cout << "Comparison results saved to " << filepath << std::endl;
     } else {
         std::cerr << "Warning: Could not save comparison results to " << filepath << std::endl;
     }
-}
\ No newline at end of file
+}
+
+// HyperparameterSearch Implementation
+
+std::vector<SearchTrial> HyperparameterSearch::run(
+    const std::vector<std::map<std::string, double>>& candidates,
+    int min_episodes, int max_episodes, int reduction_factor) {
+    
+    int eta = std::max(2, reduction_factor);
+    max_episodes = std::max(1, max_episodes);
+    int budget = std::min(std::max(1, min_episodes), max_episodes);
+    
+    long base_seed = (base_config.seed >= 0) ? base_config.seed :
+                     (long)(std::random_device{}() & 0x3fffffff);
+    
+    std::vector<SearchTrial> trials;
+    for (size_t k = 0; k < candidates.size(); k++) {
+        trials.emplace_back(k, candidates[k]);
+    }
+    std::vector<std::unique_ptr<SingleAgentTrainer>> trainers(trials.size());
+    std::vector<int> alive(trials.size());
+    std::iota(alive.begin(), alive.end(), 0);
+    
+    for (int rung = 0; !alive.empty(); rung++) {
+        std::cout << "Rung " << rung << ": " << alive.size() << " trials to " 
+                  << budget << " episodes" << std::endl;
+        
+        TrainingUtils::parallel_for(alive.size(), num_threads, [&](int job) {
+            SearchTrial& trial = trials[alive[job]];
+            long trial_seed = base_seed + trial.id;
+            
+            if (!trainers[trial.id]) {
+                TrainingConfig trial_config = base_config;
+                for (const auto& [name, value] : trial.params) {
+                    trial_config.agent_params[name] = value;
+                }
+                trial_config.seed = trial_seed;
+                trial_config.verbose = false;
+                trial_config.save_model = false;
+                trial_config.save_metrics = false;
+                trainers[trial.id] = std::make_unique<SingleAgentTrainer>(trial_config);
+            } else {
+                // A trial may resume on another thread; reseed that thread's
+                // environment stream so the rung does not depend on scheduling
+                RNDInit(TrainingUtils::evaluation_episode_seed(trial_seed, rung));
+            }
+            
+            SingleAgentTrainer& trainer = *trainers[trial.id];
+            trainer.set_episodes(budget - trial.episodes_trained);
+            trainer.train();
+            
+            trial.episodes_trained = budget;
+            trial.rung = rung;
+            trial.score = trainer.get_metrics().reward_stats.mean();
+        });
+        
+        if (budget >= max_episodes) break;
+        
+        // Promote the best 1/eta to the next rung
+        std::stable_sort(alive.begin(), alive.end(), [&](int a, int b) {
+            return trials[a].score > trials[b].score;
+        });
+        size_t keep = std::max<size_t>(1, alive.size() / eta);
+        for (size_t j = keep; j < alive.size(); j++) {
+            trainers[alive[j]].reset();
+        }
+        alive.resize(keep);
+        budget = (int)std::min<long>(max_episodes, (long)budget * eta);
+    }
+    
+    std::stable_sort(trials.begin(), trials.end(), [](const SearchTrial& a, const SearchTrial& b) {
+        if (a.rung != b.rung) return a.rung > b.rung;
+        return a.score > b.score;
+    });
+    return trials;
+}
+
+void HyperparameterSearch::print_results(const std::vector<SearchTrial>& trials, size_t top) {
+    std::cout << "\n=== Hyperparameter Search Results ===" << std::endl;
+    std::cout << std::setw(6) << "Rank"
+              << std::setw(8) << "Trial"
+              << std::setw(10) << "Episodes"
+              << std::setw(15) << "Score" << "  Parameters" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    
+    for (size_t r = 0; r < std::min(top, trials.size()); r++) {
+        const SearchTrial& trial = trials[r];
+        std::cout << std::setw(6) << r + 1
+                  << std::setw(8) << trial.id
+                  << std::setw(10) << trial.episodes_trained
+                  << std::setw(15) << std::fixed << std::setprecision(3) << trial.score << "  ";
+        bool first = true;
+        for (const auto& [name, value] : trial.params) {
+            std::cout << (first ? "" : ",") << name << "=" << std::defaultfloat << value;
+            first = false;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "=====================================\n" << std::endl;
+}
+
+void HyperparameterSearch::save_results(const std::vector<SearchTrial>& trials,
+                                        const std::string& filepath) {
+    std::ofstream file(filepath);
+    if (file.is_open()) {
+        // One column per parameter that any trial sets
+        std::set<std::string> names;
+        for (const SearchTrial& trial : trials) {
+            for (const auto& entry : trial.params) {
+                names.insert(entry.first);
+            }
+        }
+        
+        file << "rank,trial,rung,episodes,score";
+        for (const std::string& name : names) {
+            file << "," << name;
+        }
+        file << "\n";
+        
+        for (size_t r = 0; r < trials.size(); r++) {
+            const SearchTrial& trial = trials[r];
+            file << r + 1 << "," << trial.id << "," << trial.rung << ","
+                 << trial.episodes_trained << "," << trial.score;
+            for (const std::string& name : names) {
+                file << ",";
+                auto it = trial.params.find(name);
+                if (it != trial.params.end()) {
+                    file << it->second;
+                }
+            }
+            file << "\n";
+        }
+        file.close();
+        std::cout << "Search results saved to " << filepath << std::endl;
+    } else {
+        std::cerr << "Warning: Could not save search results to " << filepath << std::endl;
+    }
+}
+
+// PopulationBasedTrainer Implementation
+
+PopulationBasedTrainer::PopulationBasedTrainer(const TrainingConfig& config, int population_size,
+                                               int num_threads, double truncation)
+    : base_config(config), num_threads(num_threads),
+      truncation(std::min(0.5, std::max(0.0, truncation))) {
+    
+    base_seed = (base_config.seed >= 0) ? base_config.seed :
+                (long)(std::random_device{}() & 0x3fffffff);
+    rng.seed(base_seed);
+    
+    for (int k = 0; k < std::max(1, population_size); k++) {
+        TrainingConfig member_config = base_config;
+        member_config.seed = base_seed + k;
+        member_config.verbose = false;
+        member_config.save_model = false;
+        member_config.save_metrics = false;
+        trainers.push_back(std::make_unique<SingleAgentTrainer>(member_config));
+        
+        RLAgent* agent = trainers.back()->get_agent();
+        if (k > 0) {
+            agent->set_hyperparameters(perturb(agent->get_hyperparameters(), 0.5, 2.0, true));
+        }
+        members.emplace_back(k);
+        members.back().hyperparameters = agent->get_hyperparameters();
+    }
+}
+
+std::map<std::string, double> PopulationBasedTrainer::perturb(
+    const std::map<std::string, double>& hyperparameters, double low, double high,
+    bool log_uniform) {
+    std::map<std::string, double> result;
+    for (const auto& [name, value] : hyperparameters) {
+        double factor;
+        if (log_uniform) {
+            factor = std::exp(std::uniform_real_distribution<double>(std::log(low), std::log(high))(rng));
+        } else {
+            factor = std::bernoulli_distribution(0.5)(rng) ? high : low;
+        }
+        double perturbed = value * factor;
+        // Keep exploration a probability and returns discounted
+        if (name == "epsilon") perturbed = std::min(1.0, perturbed);
+        if (name == "gamma") perturbed = std::min(0.999, perturbed);
+        result[name] = perturbed;
+    }
+    return result;
+}
+
+std::vector<PopulationMember> PopulationBasedTrainer::train(int episodes, int ready_interval,
+                                                            const std::string& history_path) {
+    int population = trainers.size();
+    int interval = std::max(1, ready_interval);
+    
+    std::ofstream history;
+    if (!history_path.empty()) {
+        history.open(history_path);
+        if (!history.is_open()) {
+            throw std::runtime_error("Could not open file for writing: " + history_path);
+        }
+        history << "round,episodes,rank,member,score,parent,learning_rate,epsilon,gamma\n";
+    }
+    
+    std::vector<int> ranking(population);
+    int trained = 0;
+    for (int round = 0; trained < episodes; round++) {
+        int round_episodes = std::min(interval, episodes - trained);
+        
+        TrainingUtils::parallel_for(population, num_threads, [&](int k) {
+            // Members move between threads; reseed this thread's environment
+            // stream so a round does not depend on scheduling
+            RNDInit(TrainingUtils::evaluation_episode_seed(base_seed + k, round));
+            
+            SingleAgentTrainer& trainer = *trainers[k];
+            trainer.set_episodes(round_episodes);
+            trainer.train();
+            
+            const std::vector<double>& rewards = trainer.get_metrics().episode_rewards;
+            members[k].score = std::accumulate(rewards.end() - round_episodes, rewards.end(), 0.0) /
+                               round_episodes;
+            members[k].hyperparameters = trainer.get_agent()->get_hyperparameters();
+        });
+        trained += round_episodes;
+        
+        std::iota(ranking.begin(), ranking.end(), 0);
+        std::stable_sort(ranking.begin(), ranking.end(), [&](int a, int b) {
+            return members[a].score > members[b].score;
+        });
+        
+        if (history.is_open()) {
+            for (int r = 0; r < population; r++) {
+                const PopulationMember& member = members[ranking[r]];
+                history << round << "," << trained << "," << r + 1 << "," << member.id << ","
+                        << member.score << "," << member.parent;
+                for (const char* name : {"learning_rate", "epsilon", "gamma"}) {
+                    history << ",";
+                    auto it = member.hyperparameters.find(name);
+                    if (it != member.hyperparameters.end()) {
+                        history << it->second;
+                    }
+                }
+                history << "\n";
+            }
+            history.flush();
+        }
+        
+        if (trained >= episodes) break;
+        
+        // Exploit and explore: the bottom fraction copies the top fraction
+        int cutoff = (int)(population * truncation);
+        if (cutoff == 0 && truncation > 0.0 && population >= 2) cutoff = 1;
+        for (int r = population - cutoff; r < population; r++) {
+            int loser = ranking[r];
+            int winner = ranking[std::uniform_int_distribution<int>(0, cutoff - 1)(rng)];
+            
+            std::unique_ptr<RLAgent> agent = trainers[winner]->get_agent()->clone();
+            agent->reseed(TrainingUtils::evaluation_episode_seed(base_seed + loser, round));
+            agent->set_hyperparameters(perturb(agent->get_hyperparameters(), 0.8, 1.2, false));
+            
+            members[loser].hyperparameters = agent->get_hyperparameters();
+            members[loser].parent = winner;
+            members[loser].replacements++;
+            trainers[loser]->set_agent(std::move(agent));
+        }
+        
+        if (base_config.verbose) {
+            const PopulationMember& best = members[ranking[0]];
+            std::cout << "Episodes " << trained << ": best member " << best.id << " (reward "
+                      << std::fixed << std::setprecision(2) << best.score << "), "
+                      << cutoff << " members replaced" << std::endl;
+        }
+    }
+    
+    std::vector<PopulationMember> result;
+    for (int k : ranking) {
+        result.push_back(members[k]);
+    }
+    return result;
+}
+
+void PopulationBasedTrainer::print_results(const std::vector<PopulationMember>& ranking) {
+    std::cout << "\n=== Population-Based Training Results ===" << std::endl;
+    std::cout << std::setw(6) << "Rank"
+              << std::setw(8) << "Member"
+              << std::setw(15) << "Score"
+              << std::setw(8) << "Parent"
+              << std::setw(10) << "Replaced" << "  Hyperparameters" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    
+    for (size_t r = 0; r < ranking.size(); r++) {
+        const PopulationMember& member = ranking[r];
+        std::cout << std::setw(6) << r + 1
+                  << std::setw(8) << member.id
+                  << std::setw(15) << std::fixed << std::setprecision(3) << member.score
+                  << std::setw(8) << member.parent
+                  << std::setw(10) << member.replacements << "  ";
+        bool first = true;
+        for (const auto& [name, value] : member.hyperparameters) {
+            std::cout << (first ? "" : ",") << name << "=" << std::defaultfloat << value;
+            first = false;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "=========================================\n" << std::endl;
+}
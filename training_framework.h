@@ -14,51 +14,236 @@
 #include <map>
 #include <chrono>
 #include <fstream>
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 #include "minority_game_env.h"
 #include "rl_agents.h"
 
+// Metrics file formats. Binary files (.bin) are columnar, all values
+// little-endian:
+//   header  "MGMETRIC", uint32 version, uint32 column count, then per column
+//           uint32 type and uint32 name length followed by the name bytes
+//   chunk   uint32 "CHNK", uint32 row count, then all values of each column
+//   trailer uint32 "TIME", uint32 0, float64 training time in seconds
+// Every section is zero-padded to a multiple of 8 bytes, so the columns of a
+// memory-mapped file are aligned and can be read in place.
+enum class MetricsFormat {
+    CSV,
+    BINARY
+};
+
+enum class MetricsColumnType : uint32_t {
+    FLOAT64 = 0,
+    INT32 = 1
+};
+
+struct MetricsColumn {
+    std::string name;
+    MetricsColumnType type;
+    
+    MetricsColumn(const std::string& name, MetricsColumnType type = MetricsColumnType::FLOAT64)
+        : name(name), type(type) {}
+    MetricsColumn(const char* name, MetricsColumnType type = MetricsColumnType::FLOAT64)
+        : name(name), type(type) {}
+};
+
+// Statistics of the last `window` values, each updated in O(1) per add: a
+// ring buffer with Kahan-compensated running sums for the mean and standard
+// deviation, monotonic deques for the minimum and maximum, and an
+// exponential moving average (alpha = 2 / (window + 1)) over all values.
+// The running sums are recomputed from the buffer every `window` adds so
+// rounding errors from values leaving the window cannot accumulate.
+class RollingStatistics {
+private:
+    int window;
+    double ema_alpha;
+    std::vector<double> buffer;
+    int next;                       // Ring position of the next value
+    int count;                      // Values in the window
+    int adds_since_renormalize;
+    long total_added;
+    double sum, sum_compensation;
+    double sum_sq, sum_sq_compensation;
+    double ema_value;
+    std::deque<std::pair<long, double>> min_candidates;  // (index, value), values increasing
+    std::deque<std::pair<long, double>> max_candidates;  // (index, value), values decreasing
+    
+    void renormalize();
+    
+public:
+    RollingStatistics(int window = 100);
+    
+    void add(double value);
+    void clear();
+    
+    double mean() const;
+    double std() const;             // Sample standard deviation, as calculate_std
+    double min() const;
+    double max() const;
+    double ema() const { return ema_value; }
+    int size() const { return count; }
+    int get_window() const { return window; }
+};
+
 // Training metrics for tracking performance
 struct TrainingMetrics {
     std::vector<double> episode_rewards;
     std::vector<double> win_rates;
-    std::vector<double> average_rewards;
+    std::vector<double> average_rewards;   // Rolling mean reward after each episode
     std::vector<int> episode_lengths;
     std::chrono::duration<double> training_time;
     
-    TrainingMetrics() : training_time(0) {}
+    // Over the last rolling_window episodes
+    RollingStatistics reward_stats;
+    RollingStatistics win_rate_stats;
+    
+    TrainingMetrics(int rolling_window = 100)
+        : training_time(0), reward_stats(rolling_window), win_rate_stats(rolling_window) {}
     
     void add_episode(double reward, double win_rate, int length) {
         episode_rewards.push_back(reward);
         win_rates.push_back(win_rate);
         episode_lengths.push_back(length);
         
-        // Calculate running average reward
-        if (episode_rewards.size() >= 100) {
-            double sum = 0.0;
-            for (int i = episode_rewards.size() - 100; i < (int)episode_rewards.size(); i++) {
-                sum += episode_rewards[i];
-            }
-            average_rewards.push_back(sum / 100.0);
-        } else {
-            double sum = 0.0;
-            for (double r : episode_rewards) {
-                sum += r;
-            }
-            average_rewards.push_back(sum / episode_rewards.size());
-        }
+        reward_stats.add(reward);
+        win_rate_stats.add(win_rate);
+        average_rewards.push_back(reward_stats.mean());
     }
     
+    // Per-episode columns after the episode number, as saved and streamed
+    static std::vector<MetricsColumn> columns();
+    
+    // CSV, or the binary format when the path ends in .bin
     void save_to_file(const std::string& filepath) const;
     void load_from_file(const std::string& filepath);
     void print_summary() const;
 };
 
+// Append-only sink for episode metrics: a CSV in the layout of
+// TrainingMetrics::save_to_file, or a binary file with one chunk per flush.
+// Both start with an int32 episode column followed by `columns`. Rows are
+// buffered in memory and every flush_interval rows the batch is handed to a
+// background thread that appends it to the file and flushes it, so a crash
+// loses at most flush_interval episodes and rows already written are never
+// rewritten. In append mode an existing file with the same columns is
+// extended and episode numbers continue after its last row.
+class MetricsStreamWriter {
+private:
+    std::string filepath;
+    std::vector<MetricsColumn> columns;
+    MetricsFormat format;
+    int flush_interval;
+    std::ofstream file;
+    long next_episode;                  // Episode number of the next added row
+    std::vector<double> pending;        // Rows not yet handed to the writer thread
+    
+    std::deque<std::vector<double>> batches;
+    std::deque<long> batch_first_episodes;
+    bool writing;
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::thread writer_thread;
+    
+    void write_header();
+    void write_rows(const std::vector<double>& batch, long first_episode);
+    void write_loop();
+    
+public:
+    MetricsStreamWriter(const std::string& filepath, const std::vector<MetricsColumn>& columns,
+                        int flush_interval = 100, bool append = false,
+                        MetricsFormat format = MetricsFormat::CSV);
+    ~MetricsStreamWriter();
+    
+    MetricsStreamWriter(const MetricsStreamWriter&) = delete;
+    MetricsStreamWriter& operator=(const MetricsStreamWriter&) = delete;
+    
+    // One value per column; missing values are written as 0
+    void add_row(const std::vector<double>& values);
+    
+    // Hand buffered rows to the writer thread; with wait, return once they
+    // are on disk
+    void flush(bool wait = false);
+    
+    // Write all remaining rows and stop the writer thread. A non-negative
+    // training time is written as the trailer, after which the file must not
+    // be appended to.
+    void close(double training_time_seconds = -1.0);
+    
+    // Rows in the file or handed to the writer thread (not the buffered ones)
+    long get_row_count() const { return next_episode; }
+    const std::string& get_filepath() const { return filepath; }
+};
+
+// Read-only view of a binary metrics file. The file is memory-mapped and
+// column data is returned as pointers into the mapping, so nothing is
+// copied or parsed per value. A chunk cut short by a crash ends the data.
+class MetricsFileReader {
+private:
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int fd;
+#endif
+    
+    std::vector<MetricsColumn> columns;
+    std::vector<long> chunk_rows;
+    std::vector<long> chunk_first_rows;
+    std::vector<std::vector<const char*>> chunk_columns;  // [chunk][column]
+    long total_rows;
+    double training_time;                                 // -1 without a trailer
+    
+    void unmap();
+    void parse();
+    
+public:
+    explicit MetricsFileReader(const std::string& filepath);
+    ~MetricsFileReader();
+    
+    MetricsFileReader(const MetricsFileReader&) = delete;
+    MetricsFileReader& operator=(const MetricsFileReader&) = delete;
+    
+    // True when the file starts with the binary metrics header
+    static bool is_binary_file(const std::string& filepath);
+    
+    int num_columns() const { return columns.size(); }
+    const MetricsColumn& column(int index) const { return columns[index]; }
+    int column_index(const std::string& name) const;  // -1 if absent
+    long num_rows() const { return total_rows; }
+    int num_chunks() const { return chunk_rows.size(); }
+    long chunk_size(int chunk) const { return chunk_rows[chunk]; }
+    double get_training_time() const { return training_time; }
+    
+    // Values of a column within one chunk, in place
+    const double* float64_column(int column, int chunk) const;
+    const int32_t* int32_column(int column, int chunk) const;
+    
+    // One value of any column type
+    double value(int column, long row) const;
+    // All values of a column, copied
+    std::vector<double> read_column(int column) const;
+    
+    // Write the file as a CSV in the streamed CSV layout
+    void write_csv(const std::string& csv_path) const;
+};
+
 // Configuration for training parameters
 struct TrainingConfig {
     int episodes;
     int render_frequency;
     int save_frequency;
     bool save_model;
+    bool save_metrics;         // Write the metrics CSV
+    int metrics_flush_interval;  // Stream metrics every N episodes, 0 to write them at the end
+    MetricsFormat metrics_format;
     bool verbose;
     std::string model_save_path;
     std::string metrics_save_path;
@@ -70,6 +255,22 @@ struct TrainingConfig {
     int equilibration_time;
     int max_episode_steps;
     long seed;
+    ResetPolicy reset_policy;
+    
+    // Parallel training (qlearning only): actor threads, each with its own
+    // environment, updating one shared Q-table
+    int num_threads;
+    SharedUpdateMode shared_update_mode;
+    
+    // Actor-learner training (any agent): num_threads actors act on a policy
+    // snapshot and feed transitions through a lock-free queue to a single
+    // learner that owns the agent
+    bool actor_learner;
+    int queue_capacity;
+    int policy_sync_interval;  // Learned transitions between policy snapshots
+    
+    int eval_threads;          // Threads used by evaluate(), 0 for every hardware thread
+    int rolling_window;        // Episodes covered by the rolling metrics
     
     // Agent parameters
     std::string agent_type;
@@ -77,10 +278,41 @@ struct TrainingConfig {
     
     TrainingConfig() 
         : episodes(1000), render_frequency(100), save_frequency(500),
-          save_model(true), verbose(true), model_save_path("models/"),
+          save_model(true), save_metrics(true), metrics_flush_interval(100),
+          metrics_format(MetricsFormat::CSV), verbose(true), model_save_path("models/"),
           metrics_save_path("metrics/"), num_players(101), memory_size(3),
           num_strategies(2), equilibration_time(500), max_episode_steps(10000),
-          seed(-1), agent_type("qlearning") {}
+          seed(-1), reset_policy(ResetPolicy::FULL), num_threads(1),
+          shared_update_mode(SharedUpdateMode::HOGWILD), actor_learner(false),
+          queue_capacity(65536), policy_sync_interval(1000), eval_threads(1),
+          rolling_window(100), agent_type("qlearning") {}
+};
+
+// Counters of an actor-learner training run
+struct ActorLearnerStats {
+    long transitions_pushed;
+    long transitions_dropped;    // Discarded because the queue was full
+    long transitions_learned;
+    size_t max_queue_depth;
+    double mean_queue_depth;     // Depth seen by the learner at each pop
+    long policy_versions;        // Snapshots published, including the initial one
+    double mean_policy_lag;      // Snapshots published between acting and learning
+    long max_policy_lag;
+    
+    ActorLearnerStats()
+        : transitions_pushed(0), transitions_dropped(0), transitions_learned(0),
+          max_queue_depth(0), mean_queue_depth(0.0), policy_versions(0),
+          mean_policy_lag(0.0), max_policy_lag(0) {}
+    
+    void print() const;
+};
+
+// Per-episode results of a policy evaluation, in episode order
+struct EvaluationResult {
+    std::vector<double> rewards;
+    std::vector<double> win_rates;
+    std::vector<double> non_rl_avg_win_rates;
+    std::vector<double> non_rl_std_win_rates;
 };
 
 // Single agent trainer
@@ -95,6 +327,22 @@ private:
     std::string generate_model_filename() const;
     std::string generate_metrics_filename() const;
     
+    ActorLearnerStats actor_learner_stats;
+    
+    // Open while train() streams metrics
+    std::unique_ptr<MetricsStreamWriter> metrics_writer;
+    
+    // Add an episode to the metrics and the metrics stream
+    void record_episode(double reward, double win_rate, int length);
+    
+    // Episode loop of train() run by config.num_threads actor threads
+    void train_parallel();
+    void train_actor_learner();
+    
+    // Environment and seed of one actor thread
+    std::unique_ptr<MinorityGameEnv> make_actor_env(unsigned int seed) const;
+    unsigned int actor_base_seed() const;
+    
 public:
     SingleAgentTrainer(const TrainingConfig& config);
     ~SingleAgentTrainer() = default;
@@ -103,6 +351,13 @@ public:
     TrainingMetrics train();
     void evaluate(int num_episodes = 100);
     
+    // Episodes run by the next train() call. Calling train() again continues
+    // with the same agent, environment and metrics.
+    void set_episodes(int episodes) { config.episodes = episodes; }
+    
+    // Continue training with another agent for the same environment
+    void set_agent(std::unique_ptr<RLAgent> new_agent) { agent = std::move(new_agent); }
+    
     // Utility methods
     void save_model(const std::string& filepath = "");
     void load_model(const std::string& filepath);
@@ -112,6 +367,7 @@ public:
     // Getters
     const TrainingMetrics& get_metrics() const { return metrics; }
     const TrainingConfig& get_config() const { return config; }
+    const ActorLearnerStats& get_actor_learner_stats() const { return actor_learner_stats; }
     RLAgent* get_agent() { return agent.get(); }
     MinorityGameEnv* get_environment() { return env.get(); }
 };
@@ -122,6 +378,8 @@ struct MultiAgentTrainingConfig {
     int render_frequency;
     int save_frequency;
     bool save_models;
+    int metrics_flush_interval;  // Stream metrics every N episodes, 0 to write them at the end
+    MetricsFormat metrics_format;
     bool verbose;
     std::string model_save_path;
     std::string metrics_save_path;
@@ -134,6 +392,15 @@ struct MultiAgentTrainingConfig {
     int equilibration_time;
     int max_episode_steps;
     long seed;
+    bool random_rl_positions;  // Place RL agents at random player positions
+    ResetPolicy reset_policy;
+    
+    // All RL players act through one agent (agent_types[0], agent_params[0])
+    // with batched predict/learn calls
+    bool share_parameters;
+    
+    int eval_threads;          // Threads used by evaluate(), 0 for every hardware thread
+    int rolling_window;        // Episodes covered by the rolling metrics
     
     // Agent parameters (can be different for each agent)
     std::vector<std::string> agent_types;
@@ -141,10 +408,13 @@ struct MultiAgentTrainingConfig {
     
     MultiAgentTrainingConfig()
         : episodes(500), render_frequency(50), save_frequency(250),
-          save_models(true), verbose(true), model_save_path("models/"),
+          save_models(true), metrics_flush_interval(100), metrics_format(MetricsFormat::CSV),
+          verbose(true), model_save_path("models/"),
           metrics_save_path("metrics/"), num_players(101), num_rl_agents(2),
           memory_size(3), num_strategies(2), equilibration_time(500),
-          max_episode_steps(10000), seed(-1) {
+          max_episode_steps(10000), seed(-1), random_rl_positions(false),
+          reset_policy(ResetPolicy::FULL), share_parameters(false), eval_threads(1),
+          rolling_window(100) {
         
         // Default: 2 Q-learning agents
         agent_types = {"qlearning", "qlearning"};
@@ -156,11 +426,17 @@ struct MultiAgentTrainingConfig {
 struct MultiAgentTrainingMetrics {
     std::vector<std::vector<double>> episode_rewards;  // [agent][episode]
     std::vector<std::vector<double>> win_rates;        // [agent][episode]
-    std::vector<std::vector<double>> average_rewards;  // [agent][episode]
+    std::vector<std::vector<double>> average_rewards;  // [agent][episode], rolling mean
     std::vector<int> episode_lengths;
     std::chrono::duration<double> training_time;
     
-    MultiAgentTrainingMetrics(int num_agents) : training_time(0) {
+    // Per agent, over the last rolling_window episodes
+    std::vector<RollingStatistics> reward_stats;
+    std::vector<RollingStatistics> win_rate_stats;
+    
+    MultiAgentTrainingMetrics(int num_agents, int rolling_window = 100)
+        : training_time(0), reward_stats(num_agents, RollingStatistics(rolling_window)),
+          win_rate_stats(num_agents, RollingStatistics(rolling_window)) {
         episode_rewards.resize(num_agents);
         win_rates.resize(num_agents);
         average_rewards.resize(num_agents);
@@ -168,20 +444,37 @@ struct MultiAgentTrainingMetrics {
     
     void add_episode(const std::vector<double>& rewards, 
                     const std::vector<double>& win_rates_vec, int length);
+    
+    // Per-episode columns after the episode number, as saved and streamed
+    static std::vector<MetricsColumn> columns(int num_agents);
+    
+    // CSV, or the binary format when the path ends in .bin
     void save_to_file(const std::string& filepath) const;
     void load_from_file(const std::string& filepath);
-    void print_summary() const;
+    // Per-agent results, or statistics across agents when aggregate is set
+    void print_summary(bool aggregate = false) const;
 };
 
 // Multi-agent trainer
 class MultiAgentTrainer {
 private:
     std::unique_ptr<MultiAgentMinorityGameEnv> env;
-    std::vector<std::unique_ptr<RLAgent>> agents;
+    std::vector<std::unique_ptr<RLAgent>> agents;  // One agent when parameters are shared
     MultiAgentTrainingConfig config;
     MultiAgentTrainingMetrics metrics;
     
+    // Per-step buffers for the batched shared-parameter path
+    std::vector<int> step_actions;
+    std::vector<uint8_t> step_dones;
+    
+    // Open while train() streams metrics
+    std::unique_ptr<MetricsStreamWriter> metrics_writer;
+    
     void create_directories();
+    void select_actions(const std::vector<Observation>& observations, bool deterministic);
+    void learn_step(const std::vector<Observation>& observations, const std::vector<double>& rewards,
+                    const std::vector<Observation>& next_observations, bool done);
+    std::vector<double> episode_win_rates(const MultiAgentMinorityGameEnv& episode_env) const;
     std::string generate_model_filename(int agent_idx) const;
     std::string generate_metrics_filename() const;
     
@@ -209,22 +502,41 @@ public:
 // Utility functions for agent comparison
 struct ComparisonResult {
     std::string agent_name;
-    double average_reward;
+    double average_reward;       // Mean over seeds of each run's mean episode reward
     double average_win_rate;
-    double std_reward;
+    double std_reward;           // Over all episodes of all seeds
     double std_win_rate;
     
+    // Confidence interval of the mean across seeds (across the episodes of
+    // the single run when only one seed was trained)
+    std::pair<double, double> reward_ci;
+    std::pair<double, double> win_rate_ci;
+    
+    // Mean episode reward and win rate of each seed's run
+    std::vector<double> seed_rewards;
+    std::vector<double> seed_win_rates;
+    
     ComparisonResult(const std::string& name) 
         : agent_name(name), average_reward(0.0), average_win_rate(0.0),
-          std_reward(0.0), std_win_rate(0.0) {}
+          std_reward(0.0), std_win_rate(0.0), reward_ci(0.0, 0.0), win_rate_ci(0.0, 0.0) {}
 };
 
+// Trains every agent type for num_seeds seeds. Runs are independent jobs on
+// up to num_threads threads (0 for every hardware thread), each with its own
+// environment and RNG stream seeded from base_config.seed + seed index.
+// Models and metrics are written only when persist is set, each run to its
+// own compare_<agent>_s<k>/ subdirectory.
 class AgentComparator {
 private:
     TrainingConfig base_config;
+    int num_seeds;
+    int num_threads;
+    bool persist;
     
 public:
-    AgentComparator(const TrainingConfig& config) : base_config(config) {}
+    AgentComparator(const TrainingConfig& config, int num_seeds = 1, int num_threads = 1,
+                    bool persist = false)
+        : base_config(config), num_seeds(num_seeds), num_threads(num_threads), persist(persist) {}
     
     std::vector<ComparisonResult> compare_agents(
         const std::vector<std::string>& agent_types,
@@ -236,25 +548,153 @@ public:
                                 const std::string& filepath);
 };
 
+// One configuration of a hyperparameter search
+struct SearchTrial {
+    int id;
+    std::map<std::string, double> params;  // Overrides of the base agent_params
+    int episodes_trained;
+    int rung;                              // Last rung the trial was trained in
+    double score;                          // Rolling mean reward after that rung
+    
+    SearchTrial(int id, const std::map<std::string, double>& params)
+        : id(id), params(params), episodes_trained(0), rung(0), score(0.0) {}
+};
+
+// Successive-halving search over agent_params. Every candidate is trained
+// for min_episodes; after each rung only the best 1/reduction_factor by
+// rolling mean reward keep training, to reduction_factor times as many
+// episodes, until max_episodes is reached. The trials of a rung run on up
+// to num_threads threads (0 for every hardware thread), and trial k is
+// seeded from base_config.seed + k, so results do not depend on the
+// thread count.
+class HyperparameterSearch {
+private:
+    TrainingConfig base_config;
+    int num_threads;
+    
+public:
+    HyperparameterSearch(const TrainingConfig& config, int num_threads = 1)
+        : base_config(config), num_threads(num_threads) {}
+    
+    // All trials, those that reached the last rung first, each rung by score
+    std::vector<SearchTrial> run(const std::vector<std::map<std::string, double>>& candidates,
+                                 int min_episodes, int max_episodes, int reduction_factor = 3);
+    
+    void print_results(const std::vector<SearchTrial>& trials, size_t top = 10);
+    void save_results(const std::vector<SearchTrial>& trials, const std::string& filepath);
+};
+
+// One member of a population-based training run
+struct PopulationMember {
+    int id;
+    std::map<std::string, double> hyperparameters;  // Current agent hyperparameters
+    double score;                                   // Mean reward of the last interval
+    int parent;                                     // Member last copied from, -1 if none
+    int replacements;                               // Times the member was replaced
+    
+    PopulationMember(int id)
+        : id(id), score(0.0), parent(-1), replacements(0) {}
+};
+
+// Population-based training: population_size agents of base_config train
+// concurrently on up to num_threads threads (0 for every hardware thread).
+// Every ready_interval episodes the members are ranked by their mean reward
+// over the interval, and each member in the bottom truncation fraction is
+// replaced by an in-memory clone of a random member of the top fraction,
+// with learning_rate, epsilon and gamma each multiplied by 0.8 or 1.2.
+// Members other than the first start from hyperparameters scaled by random
+// factors in [0.5, 2]. Member k is seeded from base_config.seed + k.
+class PopulationBasedTrainer {
+private:
+    TrainingConfig base_config;
+    int num_threads;
+    double truncation;
+    long base_seed;
+    std::mt19937 rng;  // Initial scaling, partner choice and perturbations
+    
+    std::vector<std::unique_ptr<SingleAgentTrainer>> trainers;
+    std::vector<PopulationMember> members;
+    
+    std::map<std::string, double> perturb(const std::map<std::string, double>& hyperparameters,
+                                          double low, double high, bool log_uniform);
+    
+public:
+    PopulationBasedTrainer(const TrainingConfig& config, int population_size,
+                           int num_threads = 1, double truncation = 0.25);
+    
+    // Train every member for episodes episodes. Returns the members best
+    // first; the ranking of every interval is appended to history_path.
+    std::vector<PopulationMember> train(int episodes, int ready_interval,
+                                        const std::string& history_path = "");
+    
+    SingleAgentTrainer& get_trainer(int id) { return *trainers[id]; }
+    
+    void print_results(const std::vector<PopulationMember>& ranking);
+};
+
 // Training utilities
 namespace TrainingUtils {
     // Create default configurations
     TrainingConfig create_default_single_config();
     MultiAgentTrainingConfig create_default_multi_config();
     
-    // Parameter sweep utilities
+    // Parameter sweep utilities: every combination of the listed values, and
+    // num_samples draws uniform in [low, high] per parameter
     std::vector<std::map<std::string, double>> create_parameter_grid(
         const std::map<std::string, std::vector<double>>& param_ranges);
+    std::vector<std::map<std::string, double>> sample_parameters(
+        const std::map<std::string, std::pair<double, double>>& param_ranges,
+        int num_samples, long seed);
     
     // Statistical utilities
     double calculate_mean(const std::vector<double>& values);
     double calculate_std(const std::vector<double>& values);
+    // Student-t interval (lower, upper) for the mean of values
     std::pair<double, double> calculate_confidence_interval(
         const std::vector<double>& values, double confidence = 0.95);
     
     // File utilities
     void ensure_directory_exists(const std::string& path);
     std::string get_timestamp_string();
+    
+    // Parse a reset policy name (full, keep, continue)
+    ResetPolicy parse_reset_policy(const std::string& name);
+    
+    // Parse a shared Q-table update mode name (hogwild, striped)
+    SharedUpdateMode parse_shared_update_mode(const std::string& name);
+    
+    // Parse an exploration schedule name (exponential, linear, step)
+    ScheduleType parse_schedule_type(const std::string& name);
+    
+    // Parse a metrics format name (csv, binary)
+    MetricsFormat parse_metrics_format(const std::string& name);
+    // Format implied by a metrics file name, and the extension of a format
+    MetricsFormat metrics_format_for_path(const std::string& path);
+    std::string metrics_extension(MetricsFormat format);
+    
+    // Evaluate the agent's deterministic policy for num_episodes episodes on
+    // up to num_threads threads (0 for every hardware thread). Episode k runs
+    // in a fresh environment built from env_config and seeded from
+    // (env_config.seed, k), and the threads share a read-only table of the
+    // greedy action of every memory state, so the results are the same for
+    // any thread count. Agents without a deterministic policy, and memory
+    // sizes above QTable::DENSE_MAX_BITS, are evaluated on the calling thread.
+    // Only agents without a deterministic policy are changed, through their RNG.
+    EvaluationResult evaluate_policy(RLAgent& agent, const TrainingConfig& env_config,
+                                     int num_episodes, int num_threads = 1);
+    
+    // Greedy action of every memory state under the agent's deterministic
+    // policy, read through RLAgent::greedy_actions without changing the agent
+    std::vector<uint8_t> greedy_policy_table(const RLAgent& agent, int memory_size);
+    
+    // Seed of evaluation episode k for a base seed
+    long evaluation_episode_seed(long base_seed, int episode);
+    
+    // Run job(0) ... job(num_jobs - 1) on up to num_threads threads, handing
+    // out jobs in index order as threads become free. num_threads <= 0 uses
+    // every hardware thread. The first exception thrown by a job is rethrown
+    // after all threads have finished.
+    void parallel_for(int num_jobs, int num_threads, const std::function<void(int)>& job);
 }
 
 #endif // _TRAINING_FRAMEWORK_H_